@@ -10,31 +10,55 @@ CONFIG += c++17
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    bucketpreviewwindow.cpp \
+    bucketstrip.cpp \
     classificationwindow.cpp \
+    executejournal.cpp \
+    executeoptionswidget.cpp \
     executewindow.cpp \
+    filecatalog.cpp \
+    filelistmodel.cpp \
+    filenameindex.cpp \
     filepreviewdialog.cpp \
+    hashcache.cpp \
+    iothrottle.cpp \
     main.cpp \
     mainwindow.cpp \
+    moveengine.cpp \
+    moveexecutor.cpp \
+    moveplan.cpp \
     previewwindow.cpp \
     sizepreviewwindow.cpp \
-    timepreviewwindow.cpp
+    timepreviewwindow.cpp \
+    treemapwidget.cpp
 
 HEADERS += \
+    bucketpreviewwindow.h \
+    bucketstrip.h \
     classificationwindow.h \
+    executejournal.h \
+    executeoptionswidget.h \
     executewindow.h \
+    filecatalog.h \
+    filelistmodel.h \
+    filenameindex.h \
     filepreviewdialog.h \
+    hashcache.h \
+    iothrottle.h \
     mainwindow.h \
+    moveengine.h \
+    moveexecutor.h \
+    moveplan.h \
+    parallelsort.h \
     previewwindow.h \
     sizepreviewwindow.h \
-    timepreviewwindow.h
+    timepreviewwindow.h \
+    treemapwidget.h
 
 FORMS += \
     classificationwindow.ui \
     executewindow.ui \
-    mainwindow.ui \
-    previewwindow.ui \
-    sizepreviewwindow.ui \
-    timepreviewwindow.ui
+    mainwindow.ui
 
 # Default rules for deployment.
 qnx: target.path = /tmp/$${TARGET}/bin
@@ -0,0 +1,643 @@
+// 分类效果预览窗口的公共部分：按类型、体积、修改时间三种预览共用同一套分类列与窗口
+#include "bucketpreviewwindow.h"
+#include "executewindow.h"
+#include "executeoptionswidget.h"
+#include "filepreviewdialog.h"
+#include "filelistmodel.h"
+#include "bucketstrip.h"
+#include "filenameindex.h"
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QApplication>
+#include <QMessageBox>
+#include <QSizePolicy>
+#include <QScreen>
+#include <QFileInfo>
+#include <QDir>
+
+
+BucketColumn::BucketColumn(const QString &title, FileListModel *model, const QString &folderName,
+                           int rowHeight, QWidget *parent)
+    : QFrame(parent), m_model(model)
+{
+    // 重建时按模型中的选中状态恢复切换按钮
+    m_isAllSelected = m_model->selectedCount() == m_model->fileCount();
+    setupUI(title, folderName, rowHeight);
+}
+
+void BucketColumn::selectAll()
+{
+    m_model->setAllSelected(true);
+    m_isAllSelected = true;
+    m_toggleSelectButton->setText("全不选");
+}
+
+void BucketColumn::deselectAll()
+{
+    m_model->setAllSelected(false);
+    m_isAllSelected = false;
+    m_toggleSelectButton->setText("全选");
+}
+
+void BucketColumn::invertSelection()
+{
+    m_model->invertSelection();
+    m_isAllSelected = m_model->selectedCount() == m_model->fileCount();
+    m_toggleSelectButton->setText(m_isAllSelected ? "全不选" : "全选");
+}
+
+void BucketColumn::setupUI(const QString &title, const QString &folderName, int rowHeight)
+{
+    setFrameStyle(QFrame::StyledPanel | QFrame::Raised);
+    setLineWidth(1);
+    setMinimumWidth(280);
+    setMaximumWidth(320);
+    setMinimumHeight(550);
+    setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Expanding);
+
+    // 设置样式
+    setStyleSheet(
+        "QFrame {"
+        "    border: 2px solid #cccccc;"
+        "    border-radius: 8px;"
+        "    background-color: #f9f9f9;"
+        "    margin: 5px;"
+        "}"
+        "QLabel {"
+        "    font-weight: bold;"
+        "    font-size: 11px;"
+        "    color: #333333;"
+        "    background-color: #e6e6e6;"
+        "    padding: 5px;"
+        "    border-radius: 4px;"
+        "    margin: 2px;"
+        "}"
+        "QLineEdit {"
+        "    border: 1px solid #cccccc;"
+        "    border-radius: 4px;"
+        "    padding: 3px;"
+        "    margin: 2px;"
+        "    background-color: white;"
+        "    font-size: 11px;"
+        "}"
+        "QListView {"
+        "    border: 1px solid #dddddd;"
+        "    border-radius: 4px;"
+        "    background-color: white;"
+        "    margin: 2px;"
+        "}"
+        );
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(6, 6, 6, 6);
+    layout->setSpacing(2);
+
+    m_titleLabel = new QLabel(title);
+    m_titleLabel->setAlignment(Qt::AlignCenter);
+    m_titleLabel->setWordWrap(true);
+    layout->addWidget(m_titleLabel);
+
+    // 添加右上角切换按钮
+    QHBoxLayout *titleLayout = new QHBoxLayout();
+
+    //每个文件子类的全选/全不选
+    m_toggleSelectButton = new QPushButton(m_isAllSelected ? "全不选" : "全选");
+    m_toggleSelectButton->setFixedSize(50, 20);
+    m_toggleSelectButton->setStyleSheet(
+        "QPushButton {"
+        "    border: 1px solid #ccc;"
+        "    border-radius: 3px;"
+        "    padding: 2px 4px;"
+        "    font-size: 9px;"
+        "    background-color: #f0f0f0;"
+        "}"
+        "QPushButton:hover {"
+        "    background-color: #e0e0e0;"
+        "}"
+        );
+    connect(m_toggleSelectButton, &QPushButton::clicked, this, &BucketColumn::onToggleSelectClicked);
+
+    // 让标题和按钮按 8:2 比例占宽度
+    titleLayout->addWidget(m_titleLabel, 8);
+    titleLayout->addWidget(m_toggleSelectButton, 2);
+
+    m_toggleSelectButton->setFixedHeight(22);
+    m_toggleSelectButton->setSizePolicy(QSizePolicy::Minimum, QSizePolicy::Fixed);
+    m_toggleSelectButton->setStyleSheet(
+        "QPushButton { border: 1px solid #ccc; border-radius: 3px; padding: 1px 6px; font-size: 9px; }"
+        "QPushButton:hover { background-color: #eee; }"
+        );
+    layout->addLayout(titleLayout);
+
+
+    // 文件夹名称输入框
+    QLabel *folderLabel = new QLabel("目标文件夹名称:");
+    folderLabel->setStyleSheet("font-size: 10px; margin: 1px; padding: 2px;");
+    layout->addWidget(folderLabel);
+
+    m_folderNameEdit = new QLineEdit();
+    m_folderNameEdit->setText(folderName);
+    m_folderNameEdit->setPlaceholderText("输入文件夹名称");
+    connect(m_folderNameEdit, &QLineEdit::textChanged, this, [this](const QString &text) {
+        emit folderNameChanged(text.trimmed());
+    });
+    layout->addWidget(m_folderNameEdit);
+
+    // 排序方式：第 0 项为扫描顺序，之后每种排序键依次为升序、降序；排序状态在模型里，重建时恢复
+    m_sortCombo = new QComboBox();
+    m_sortCombo->addItem("默认顺序");
+    m_sortCombo->addItem("名称 ↑");
+    m_sortCombo->addItem("名称 ↓");
+    m_sortCombo->addItem("大小 ↑");
+    m_sortCombo->addItem("大小 ↓");
+    m_sortCombo->addItem("修改时间 ↑");
+    m_sortCombo->addItem("修改时间 ↓");
+    m_sortCombo->setStyleSheet("font-size: 10px;");
+    if (m_model->sortColumn() >= 0)
+        m_sortCombo->setCurrentIndex(1 + m_model->sortColumn() * 2 + (m_model->sortOrder() == Qt::DescendingOrder ? 1 : 0));
+    connect(m_sortCombo, &QComboBox::currentIndexChanged, this, [this](int index) {
+        if (index <= 0)
+            m_model->sort(-1);
+        else
+            m_model->sort((index - 1) / 2, (index - 1) % 2 ? Qt::DescendingOrder : Qt::AscendingOrder);
+    });
+    layout->addWidget(m_sortCombo);
+
+    // 创建文件列表：行高固定，视图只为可见行调用代理绘制
+    m_fileList = new QListView();
+    m_fileList->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    m_fileList->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    m_fileList->setAlternatingRowColors(true);
+    m_fileList->setUniformItemSizes(true);
+    m_fileList->setSelectionMode(QAbstractItemView::NoSelection);
+    m_fileList->setMouseTracking(true);
+    m_fileList->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+
+    FileItemDelegate *delegate = new FileItemDelegate(rowHeight, m_fileList);
+    m_fileList->setItemDelegate(delegate);
+    m_fileList->setModel(m_model);
+
+    // 连接信号槽
+    connect(delegate, &FileItemDelegate::itemClicked, this, [this](const QModelIndex &index) {
+        emit fileClicked(m_model->fileId(index.row()));
+    });
+    connect(delegate, &FileItemDelegate::previewRequested, this, [this](const QModelIndex &index) {
+        emit previewFileRequested(m_model->fileId(index.row()));
+    });
+
+    layout->addWidget(m_fileList, 1);
+
+    setLayout(layout);
+}
+
+void BucketColumn::onToggleSelectClicked()
+{
+    // 整个位图一次切换，按钮文字与状态在 selectAll() / deselectAll() 中同步
+    if (m_isAllSelected) {
+        deselectAll();
+    } else {
+        selectAll();
+    }
+}
+
+
+BucketPreviewWindow::BucketPreviewWindow(const QSharedPointer<const FileCatalog> &catalog,
+                                         const QString &title, QWidget *parent)
+    : QDialog(parent),
+    m_catalog(catalog)
+{
+    setupUI(title);
+    setModal(true);
+
+    // 获取屏幕尺寸并设置合适的窗口大小
+    QScreen *screen = QApplication::primaryScreen();
+    QRect screenGeometry = screen->availableGeometry();
+    int screenWidth = screenGeometry.width();
+    int screenHeight = screenGeometry.height();
+
+    // 设置窗口大小为屏幕的90%
+    int windowWidth = static_cast<int>(screenWidth * 0.9);
+    int windowHeight = static_cast<int>(screenHeight * 0.9);
+
+    resize(windowWidth, windowHeight);
+
+    // 居中显示
+    move((screenWidth - windowWidth) / 2, (screenHeight - windowHeight) / 2);
+}
+
+void BucketPreviewWindow::setupUI(const QString &title)
+{
+    setWindowTitle(title);
+    setWindowFlags(Qt::Dialog | Qt::WindowCloseButtonHint | Qt::WindowMaximizeButtonHint);
+
+    // 主布局
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(10, 10, 10, 10);
+    mainLayout->setSpacing(8);
+
+    // 标题标签
+    QLabel *titleLabel = new QLabel(title + " (点击按钮可切换文件选中状态)");
+    titleLabel->setAlignment(Qt::AlignCenter);
+    titleLabel->setStyleSheet(
+        "QLabel {"
+        "    font-size: 15px;"
+        "    font-weight: bold;"
+        "    color: #2c3e50;"
+        "    padding: 10px;"
+        "    background-color: #ecf0f1;"
+        "    border-radius: 6px;"
+        "}"
+        );
+    mainLayout->addWidget(titleLabel);
+
+    // 文件名搜索：输入时即过滤各分类列表
+    QHBoxLayout *searchLayout = new QHBoxLayout();
+    m_searchEdit = new QLineEdit();
+    m_searchEdit->setPlaceholderText("搜索文件名（不区分大小写）");
+    m_searchEdit->setClearButtonEnabled(true);
+    m_searchEdit->setEnabled(false);              // 设置索引后可用
+    m_searchResultLabel = new QLabel();
+    connect(m_searchEdit, &QLineEdit::textChanged, this, &BucketPreviewWindow::onSearchTextChanged);
+    searchLayout->addWidget(new QLabel("搜索:"));
+    searchLayout->addWidget(m_searchEdit, 1);
+    searchLayout->addWidget(m_searchResultLabel);
+    mainLayout->addLayout(searchLayout);
+
+    // 创建水平滚动区域 - 禁用垂直滚动条，分类组件按滚动位置按需创建
+    m_horizontalScrollArea = new BucketStrip();
+
+    // 设置滚动区域的样式
+    m_horizontalScrollArea->setStyleSheet(
+        "QScrollArea {"
+        "    border: 2px solid #bdc3c7;"
+        "    border-radius: 8px;"
+        "    background-color: #ffffff;"
+        "}"
+        "QScrollBar:horizontal {"
+        "    border: 1px solid #bdc3c7;"
+        "    background: #ecf0f1;"
+        "    height: 15px;"
+        "    border-radius: 7px;"
+        "}"
+        "QScrollBar::handle:horizontal {"
+        "    background: #3498db;"
+        "    border-radius: 7px;"
+        "    min-width: 30px;"
+        "}"
+        "QScrollBar::handle:horizontal:hover {"
+        "    background: #2980b9;"
+        "}"
+        );
+
+    mainLayout->addWidget(m_horizontalScrollArea, 1);
+
+    // 按钮布局
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+
+    // 执行选项（移动/复制、并发数）
+    m_executeOptionsWidget = new ExecuteOptionsWidget();
+    buttonLayout->addWidget(m_executeOptionsWidget);
+    buttonLayout->addStretch();
+
+    QPushButton *selectAllBtn = new QPushButton("全选");
+    QPushButton *deselectAllBtn = new QPushButton("全不选");
+    QPushButton *invertBtn = new QPushButton("反选");
+    QPushButton *refreshBtn = new QPushButton("刷新");
+    QPushButton *closeBtn = new QPushButton("关闭");
+    QPushButton *executeBtn = new QPushButton("执行");
+
+    // 统一按钮样式
+    QString buttonStyle =
+        "QPushButton {"
+        "    border: none;"
+        "    padding: 10px 20px;"
+        "    border-radius: 5px;"
+        "    font-weight: bold;"
+        "    font-size: 12px;"
+        "    min-width: 80px;"
+        "}";
+
+    selectAllBtn->setStyleSheet(buttonStyle +
+                                "QPushButton {"
+                                "    background-color: #27ae60;"
+                                "    color: white;"
+                                "}"
+                                "QPushButton:hover {"
+                                "    background-color: #229954;"
+                                "}"
+                                "QPushButton:pressed {"
+                                "    background-color: #1e8449;"
+                                "}");
+
+    deselectAllBtn->setStyleSheet(buttonStyle +
+                                  "QPushButton {"
+                                  "    background-color: #f39c12;"
+                                  "    color: white;"
+                                  "}"
+                                  "QPushButton:hover {"
+                                  "    background-color: #e67e22;"
+                                  "}"
+                                  "QPushButton:pressed {"
+                                  "    background-color: #d35400;"
+                                  "}");
+
+    invertBtn->setStyleSheet(buttonStyle +
+                             "QPushButton {"
+                             "    background-color: #8e44ad;"
+                             "    color: white;"
+                             "}"
+                             "QPushButton:hover {"
+                             "    background-color: #7d3c98;"
+                             "}"
+                             "QPushButton:pressed {"
+                             "    background-color: #6c3483;"
+                             "}");
+
+    refreshBtn->setStyleSheet(buttonStyle +
+                              "QPushButton {"
+                              "    background-color: #3498db;"
+                              "    color: white;"
+                              "}"
+                              "QPushButton:hover {"
+                              "    background-color: #2980b9;"
+                              "}"
+                              "QPushButton:pressed {"
+                              "    background-color: #21618c;"
+                              "}");
+
+    closeBtn->setStyleSheet(buttonStyle +
+                            "QPushButton {"
+                            "    background-color: #e74c3c;"
+                            "    color: white;"
+                            "}"
+                            "QPushButton:hover {"
+                            "    background-color: #c0392b;"
+                            "}"
+                            "QPushButton:pressed {"
+                            "    background-color: #a93226;"
+                            "}");
+    executeBtn->setStyleSheet(buttonStyle +
+                              "QPushButton {"
+                              "    background-color: #16a085;"
+                              "    color: white;"
+                              "}"
+                              "QPushButton:hover {"
+                              "    background-color: #138d75;"
+                              "}"
+                              "QPushButton:pressed {"
+                              "    background-color: #117964;"
+                              "}");
+
+    connect(selectAllBtn, &QPushButton::clicked, this, &BucketPreviewWindow::selectAllFiles);
+    connect(deselectAllBtn, &QPushButton::clicked, this, &BucketPreviewWindow::deselectAllFiles);
+    connect(invertBtn, &QPushButton::clicked, this, &BucketPreviewWindow::invertAllFiles);
+    connect(closeBtn, &QPushButton::clicked, this, &BucketPreviewWindow::onCloseButtonClicked);
+    connect(refreshBtn, &QPushButton::clicked, [this]() {
+        QMessageBox::information(this, "刷新", "刷新文件列表完成！");
+    });
+    connect(executeBtn, &QPushButton::clicked, this, &BucketPreviewWindow::onExecuteButtonClicked);
+
+    buttonLayout->addWidget(selectAllBtn);
+    buttonLayout->addWidget(deselectAllBtn);
+    buttonLayout->addWidget(invertBtn);
+    buttonLayout->addWidget(refreshBtn);
+    buttonLayout->addWidget(closeBtn);
+    buttonLayout->addWidget(executeBtn);
+    mainLayout->addLayout(buttonLayout);
+
+    setLayout(mainLayout);
+}
+
+void BucketPreviewWindow::setBuckets(const Buckets &buckets)
+{
+    clearContent();
+
+    // 每个分类先只记文件 ID（与传入的列表共享，不复制），标题只需计数；
+    // 模型（选中位图、排序、过滤）和组件等滚动到视口附近再创建
+    m_buckets.reserve(buckets.size());
+    for (auto it = buckets.begin(); it != buckets.end(); ++it) {
+        Bucket bucket;
+        bucket.key = it.key();
+        bucket.fileIds = it.value();
+        bucket.folderName = defaultFolderName(it.key());
+        m_buckets.append(bucket);
+    }
+
+    m_horizontalScrollArea->setColumns(m_buckets.size(), [this](int index, QWidget *parent) {
+        return createColumn(index, parent);
+    });
+
+    if (!m_searchEdit->text().isEmpty())
+        onSearchTextChanged(m_searchEdit->text());
+}
+
+void BucketPreviewWindow::setSearchIndex(const QSharedPointer<const FileNameIndex> &index)
+{
+    m_searchIndex = index;
+    m_searchEdit->setEnabled(!index.isNull());
+}
+
+void BucketPreviewWindow::onSearchTextChanged(const QString &text)
+{
+    if (!m_searchIndex)
+        return;
+
+    if (text.isEmpty()) {
+        m_searchMatches.clear();
+        m_searchActive = false;
+        for (const Bucket &bucket : std::as_const(m_buckets)) {
+            if (bucket.model)
+                bucket.model->clearFilter();
+        }
+        m_searchResultLabel->clear();
+        return;
+    }
+
+    // 一次查询得到整个目录表的匹配位图，各分类按自己的文件 ID 过滤；
+    // 尚未建立模型的分类只计数，建立时再按保存的位图过滤
+    m_searchMatches = m_searchIndex->search(text);
+    m_searchActive = true;
+    int shown = 0;
+    for (const Bucket &bucket : std::as_const(m_buckets)) {
+        if (bucket.model) {
+            bucket.model->setFilter(m_searchMatches);
+            shown += bucket.model->rowCount();
+        } else {
+            for (int id : bucket.fileIds)
+                shown += m_searchMatches.testBit(id) ? 1 : 0;
+        }
+    }
+    m_searchResultLabel->setText(QString("匹配 %1 个文件").arg(shown));
+}
+
+void BucketPreviewWindow::clearContent()
+{
+    // 清除现有的分类组件及模型
+    m_horizontalScrollArea->clear();
+    for (const Bucket &bucket : std::as_const(m_buckets)) {
+        if (bucket.model)
+            bucket.model->deleteLater();
+    }
+    m_buckets.clear();
+}
+
+BucketColumn *BucketPreviewWindow::createColumn(int index, QWidget *parent)
+{
+    FileListModel *model = bucketModel(index);
+    const Bucket &bucket = m_buckets.at(index);
+    BucketColumn *column = new BucketColumn(columnTitle(bucket.key, bucket.fileIds.size()),
+                                            model, bucket.folderName, rowHeight(), parent);
+
+    connect(column, &BucketColumn::previewFileRequested,
+            this, &BucketPreviewWindow::onPreviewFileRequested);
+    connect(column, &BucketColumn::fileClicked, this, [this, index](int fileId) {
+        QMessageBox::information(this, "文件选择", fileDetails(fileId, m_buckets.at(index).key));
+    });
+    connect(column, &BucketColumn::folderNameChanged, this, [this, index](const QString &folderName) {
+        m_buckets[index].folderName = folderName;
+    });
+    return column;
+}
+
+FileListModel *BucketPreviewWindow::bucketModel(int index)
+{
+    Bucket &bucket = m_buckets[index];
+    if (bucket.model)
+        return bucket.model;
+
+    // 显示文本在绘制可见行时才按 ID 从目录表生成
+    bucket.model = new FileListModel(m_catalog.data(), bucket.fileIds, this);
+    bucket.model->setDisplayFunction([this](int fileId) { return displayText(fileId); });
+    bucket.model->setToolTipFunction([this](int fileId) { return toolTip(fileId); });
+    if (!bucket.selected)
+        bucket.model->setAllSelected(false);
+    if (m_searchActive)
+        bucket.model->setFilter(m_searchMatches);
+    return bucket.model;
+}
+
+void BucketPreviewWindow::selectAllFiles()
+{
+    for (int i = 0; i < m_buckets.size(); ++i) {
+        if (BucketColumn *column = qobject_cast<BucketColumn*>(m_horizontalScrollArea->column(i)))
+            column->selectAll();
+        else if (m_buckets.at(i).model)
+            m_buckets.at(i).model->setAllSelected(true);
+        else
+            m_buckets[i].selected = true;
+    }
+}
+
+void BucketPreviewWindow::deselectAllFiles()
+{
+    for (int i = 0; i < m_buckets.size(); ++i) {
+        if (BucketColumn *column = qobject_cast<BucketColumn*>(m_horizontalScrollArea->column(i)))
+            column->deselectAll();
+        else if (m_buckets.at(i).model)
+            m_buckets.at(i).model->setAllSelected(false);
+        else
+            m_buckets[i].selected = false;
+    }
+}
+
+void BucketPreviewWindow::invertAllFiles()
+{
+    for (int i = 0; i < m_buckets.size(); ++i) {
+        if (BucketColumn *column = qobject_cast<BucketColumn*>(m_horizontalScrollArea->column(i)))
+            column->invertSelection();
+        else if (m_buckets.at(i).model)
+            m_buckets.at(i).model->invertSelection();
+        else
+            m_buckets[i].selected = !m_buckets.at(i).selected;
+    }
+}
+
+void BucketPreviewWindow::onCloseButtonClicked()
+{
+    accept();
+}
+
+void BucketPreviewWindow::onExecuteButtonClicked()
+{
+    //--------------------------------------------------
+    // 1. 收集所有选中的文件名
+    //--------------------------------------------------
+    QStringList selectedNames;
+    QMap<QString, QString> folderMapping;
+    for (const Bucket &bucket : std::as_const(m_buckets))
+    {
+        // 未滚动到过的分类同样参与：选中状态和文件夹名称都不依赖组件，没有模型时整个分类同选同不选
+        const QVector<int> ids = bucket.model ? bucket.model->selectedFileIds()
+                                              : bucket.selected ? bucket.fileIds : QVector<int>();
+        for (int id : ids)
+        {
+            const QString &file = m_catalog->fileName(id);
+            selectedNames << file;
+            folderMapping[file] = bucket.folderName;  // 记录文件名对应的文件夹名称
+        }
+    }
+
+    if (selectedNames.isEmpty()) {
+        QMessageBox::information(this,"提示","没有选中的文件，无法执行分类。");
+        return;
+    }
+
+    //--------------------------------------------------
+    // 2. 组合成绝对路径 -> QList<QFileInfo>
+    //--------------------------------------------------
+    const QDir rootDir(m_catalog->rootPath());
+    QList<QFileInfo> fileList;
+    for (const QString &name : std::as_const(selectedNames)) {
+        QString absPath = rootDir.filePath(name);
+        if (QFile::exists(absPath))
+            fileList << QFileInfo(absPath);
+    }
+
+    //--------------------------------------------------
+    // 3. 创建并执行 ExecuteWindow
+    //--------------------------------------------------
+    ExecuteOptions options = m_executeOptionsWidget->options();
+    if (options.dryRun) {
+        // 演练：先选择计划文件的保存位置
+        options.planPath = QFileDialog::getSaveFileName(this, "保存执行计划",
+                                                        QDir::home().filePath("分类计划.ndjson"),
+                                                        "执行计划 (*.ndjson)");
+        if (options.planPath.isEmpty())
+            return;
+    }
+    ExecuteWindow *executeWindow =
+        new ExecuteWindow(m_catalog->rootPath(), fileList, folderMapping, this, options);
+
+    int result = executeWindow->exec();
+    if (options.dryRun)
+        return;                       // 计划已生成，结果在执行窗口中提示过
+
+    // 文件已移动（或撤销），各分类列依据的目录表已过时：反馈后关闭窗口，由上层重新扫描
+    m_filesChanged = true;
+
+    //--------------------------------------------------
+    // 4. 给用户反馈
+    //--------------------------------------------------
+    if (result == QDialog::Accepted) {
+        QMessageBox::information(this, "操作完成",
+                                 "文件分类处理已成功完成！\n您可以查看分类结果。");
+    } else {
+        QMessageBox::information(this, "操作取消",
+                                 "文件分类操作已被取消或撤销。");
+    }
+    accept();
+}
+
+void BucketPreviewWindow::onPreviewFileRequested(int fileId)
+{
+    QString filePath = QDir(m_catalog->rootPath()).filePath(m_catalog->fileName(fileId));
+    QFileInfo fileInfo(filePath);
+
+    if (!fileInfo.exists()) {
+        QMessageBox::warning(this, "预览错误", "文件不存在: " + filePath);
+        return;
+    }
+
+    FilePreviewDialog previewDialog(fileInfo, this);
+    previewDialog.exec();
+}
@@ -0,0 +1,172 @@
+// 分类效果预览窗口的公共部分：按类型、体积、修改时间三种预览共用同一套分类列与窗口，
+// 分类只保存文件目录表中的文件 ID，不复制文件记录
+#ifndef BUCKETPREVIEWWINDOW_H
+#define BUCKETPREVIEWWINDOW_H
+
+#include <QDialog>
+#include <QFrame>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListView>
+#include <QPushButton>
+#include <QComboBox>
+#include <QMap>
+#include <QVector>
+#include <QSharedPointer>
+#include <QBitArray>
+#include "filecatalog.h"
+
+class ExecuteOptionsWidget;
+class FileListModel;
+class BucketStrip;
+class FileNameIndex;
+
+// ====================== 分类列组件 ======================
+// 一个分类的视图：标题、目标文件夹名称、文件列表。选中状态在模型里，文件夹名称由窗口保存，
+// 组件滚出视口后会被销毁
+class BucketColumn : public QFrame
+{
+    Q_OBJECT
+
+public:
+    explicit BucketColumn(const QString &title, FileListModel *model, const QString &folderName,
+                          int rowHeight, QWidget *parent = nullptr);
+
+    void selectAll();                   // 选中该分类下的所有文件
+    void deselectAll();                 // 取消选中该分类下的所有文件
+    void invertSelection();             // 反选该分类下的所有文件
+
+signals:
+    void previewFileRequested(int fileId);
+    void fileClicked(int fileId);
+    void folderNameChanged(const QString &folderName);  // 用户修改了目标文件夹名称
+
+private slots:
+    void onToggleSelectClicked();
+
+private:
+    void setupUI(const QString &title, const QString &folderName, int rowHeight);
+
+    FileListModel *m_model;             // 文件 ID 及选中状态
+    QLabel *m_titleLabel;               // 分类标题（如"文件类型: txt (5个文件)"）
+    QLineEdit *m_folderNameEdit;        // 目标文件夹名称
+    QComboBox *m_sortCombo;             // 排序方式
+    QListView *m_fileList;              // 文件列表视图，只绘制可见行
+
+    QPushButton *m_toggleSelectButton;  // 子类全（不）选
+    bool m_isAllSelected = true;        // 初始全选状态
+};
+
+// ====================== 预览窗口基类 ======================
+// 窗口布局、全选、执行、文件预览与分类方式无关；分类方式相关的文字由 BucketView<Traits> 提供
+class BucketPreviewWindow : public QDialog
+{
+    Q_OBJECT
+
+public:
+    typedef QMap<QString, QVector<int>> Buckets;   // 分类名 -> 文件 ID 列表
+
+    // 设置分类数据，分类组件及其列表模型在滚动到视口附近时才创建
+    void setBuckets(const Buckets &buckets);
+
+    // 文件名搜索所用的索引（可在后台建立中），未设置时搜索框不可用
+    void setSearchIndex(const QSharedPointer<const FileNameIndex> &index);
+
+    // 是否执行过分类（含执行后撤销）：为真时窗口所依据的目录表已过时
+    bool filesChanged() const { return m_filesChanged; }
+
+protected:
+    BucketPreviewWindow(const QSharedPointer<const FileCatalog> &catalog,
+                        const QString &title, QWidget *parent);
+
+    const FileCatalog &catalog() const { return *m_catalog; }
+
+    // ---------- 分类方式相关，由 BucketView<Traits> 实现 ----------
+    virtual QString columnTitle(const QString &key, int fileCount) const = 0;
+    virtual QString defaultFolderName(const QString &key) const = 0;
+    virtual int rowHeight() const = 0;
+    virtual QString displayText(int fileId) const = 0;     // 列表行文字
+    virtual QString toolTip(int fileId) const = 0;         // 列表行提示
+    virtual QString fileDetails(int fileId, const QString &key) const = 0;   // 点击文件时的说明
+
+private slots:
+    void selectAllFiles();              // 全选：已创建的组件同步按钮状态
+    void deselectAllFiles();            // 全不选：已创建的组件同步按钮状态
+    void invertAllFiles();              // 反选：已创建的组件同步按钮状态
+    void onCloseButtonClicked();        // 关闭对话框
+    void onExecuteButtonClicked();      // 执行
+    void onPreviewFileRequested(int fileId);
+    void onSearchTextChanged(const QString &text);   // 按文件名过滤所有分类
+
+private:
+    // 一个分类：选中状态和文件夹名称保存在这里，组件销毁重建时不丢失
+    struct Bucket {
+        QString        key;
+        QVector<int>   fileIds;          // 模型建立前只用于计数和执行
+        FileListModel *model = nullptr;  // 分类列首次创建时才建立
+        bool           selected = true;  // 模型建立前整个分类的选中状态，全选/全不选/反选只整体改变它
+        QString        folderName;
+    };
+
+    void setupUI(const QString &title);
+    void clearContent();                // 清除现有分类及组件
+    BucketColumn *createColumn(int index, QWidget *parent);
+    FileListModel *bucketModel(int index);   // 按需建立模型，带上当前选中状态和搜索过滤
+
+    QSharedPointer<const FileCatalog> m_catalog;   // 预览期间保持目录表有效
+    BucketStrip *m_horizontalScrollArea;           // 水平滚动区域，只为视口附近的分类创建组件
+    QVector<Bucket> m_buckets;                     // 所有分类
+    ExecuteOptionsWidget *m_executeOptionsWidget;  // 执行方式、并发数等选项
+
+    QSharedPointer<const FileNameIndex> m_searchIndex;
+    QLineEdit *m_searchEdit;                       // 文件名搜索框
+    QLabel *m_searchResultLabel;                   // 匹配数
+    QBitArray m_searchMatches;                     // 当前搜索的匹配位图，供之后建立的模型过滤
+    bool m_searchActive = false;
+    bool m_filesChanged = false;
+};
+
+// ====================== 按分类方式实例化的预览窗口 ======================
+// Traits 提供分类方式相关的静态函数：
+//   windowTitle()、keyLabel()、RowHeight、defaultFolderName(key)、
+//   displayText(catalog, id)、toolTip(catalog, id)、fileDetails(catalog, id)
+template <typename Traits>
+class BucketView : public BucketPreviewWindow
+{
+public:
+    explicit BucketView(const QSharedPointer<const FileCatalog> &catalog, QWidget *parent = nullptr)
+        : BucketPreviewWindow(catalog, Traits::windowTitle(), parent)
+    {
+    }
+
+protected:
+    QString columnTitle(const QString &key, int fileCount) const override
+    {
+        return QString("%1: %2 (%3个文件)").arg(Traits::keyLabel(), key).arg(fileCount);
+    }
+
+    QString defaultFolderName(const QString &key) const override
+    {
+        return Traits::defaultFolderName(key);
+    }
+
+    int rowHeight() const override { return Traits::RowHeight; }
+
+    QString displayText(int fileId) const override
+    {
+        return Traits::displayText(catalog(), fileId);
+    }
+
+    QString toolTip(int fileId) const override
+    {
+        return Traits::toolTip(catalog(), fileId);
+    }
+
+    QString fileDetails(int fileId, const QString &key) const override
+    {
+        return QString("您选择了文件:\n%1\n%2: %3")
+            .arg(Traits::fileDetails(catalog(), fileId), Traits::keyLabel(), key);
+    }
+};
+
+#endif // BUCKETPREVIEWWINDOW_H
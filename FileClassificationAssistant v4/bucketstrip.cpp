@@ -0,0 +1,77 @@
+// 预览窗口的水平分类栏：只为视口附近的分类创建列，滚远的列即销毁
+#include "bucketstrip.h"
+#include <QScrollBar>
+#include <QResizeEvent>
+
+BucketStrip::BucketStrip(QWidget *parent)
+    : QScrollArea(parent)
+{
+    setWidgetResizable(true);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);  // 禁用垂直滚动条
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    setFrameStyle(QFrame::StyledPanel);
+
+    // 内容区不用布局：列按下标直接定位，宽度由分类数决定
+    m_content = new QWidget();
+    m_content->setMinimumHeight(550 + 2 * ContentMargin);
+    setWidget(m_content);
+
+    connect(horizontalScrollBar(), &QScrollBar::valueChanged,
+            this, &BucketStrip::updateVisibleColumns);
+}
+
+void BucketStrip::setColumns(int count, const ColumnFactory &factory)
+{
+    clear();
+    m_count = count;
+    m_factory = factory;
+    m_content->setMinimumWidth(2 * ContentMargin + count * (ColumnWidth + ColumnSpacing));
+    updateVisibleColumns();
+}
+
+void BucketStrip::clear()
+{
+    for (QWidget *column : std::as_const(m_columns))
+        column->deleteLater();
+    m_columns.clear();
+    m_count = 0;
+}
+
+void BucketStrip::resizeEvent(QResizeEvent *event)
+{
+    QScrollArea::resizeEvent(event);
+    updateVisibleColumns();
+}
+
+void BucketStrip::updateVisibleColumns()
+{
+    if (m_count == 0 || !m_factory)
+        return;
+
+    // 视口覆盖的列范围，两侧各放宽 KeepAhead 列
+    const int stride = ColumnWidth + ColumnSpacing;
+    const int left = horizontalScrollBar()->value() - ContentMargin;
+    const int first = qMax(0, left / stride - KeepAhead);
+    const int last = qMin(m_count - 1, (left + viewport()->width()) / stride + KeepAhead);
+
+    // 滚出范围的列销毁，状态在列之外，重建时恢复
+    for (auto it = m_columns.begin(); it != m_columns.end();) {
+        if (it.key() < first || it.key() > last) {
+            it.value()->deleteLater();
+            it = m_columns.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    const int height = qMax(m_content->height(), m_content->minimumHeight()) - 2 * ContentMargin;
+    for (int index = first; index <= last; ++index) {
+        QWidget *column = m_columns.value(index);
+        if (!column) {
+            column = m_factory(index, m_content);
+            m_columns.insert(index, column);
+            column->show();
+        }
+        column->setGeometry(ContentMargin + index * stride, ContentMargin, ColumnWidth, height);
+    }
+}
@@ -0,0 +1,43 @@
+// 预览窗口的水平分类栏：只为视口附近的分类创建列，滚远的列即销毁
+#ifndef BUCKETSTRIP_H
+#define BUCKETSTRIP_H
+
+#include <QScrollArea>
+#include <QMap>
+#include <functional>
+
+class BucketStrip : public QScrollArea
+{
+    Q_OBJECT
+public:
+    // 为第 index 个分类创建列控件；列的状态（选中、文件夹名）应保存在列之外，列随时可能被销毁
+    typedef std::function<QWidget *(int index, QWidget *parent)> ColumnFactory;
+
+    explicit BucketStrip(QWidget *parent = nullptr);
+
+    // 设置分类数并清空已有列，之后按滚动位置按需创建
+    void setColumns(int count, const ColumnFactory &factory);
+    void clear();
+
+    int columnCount() const { return m_count; }
+    QWidget *column(int index) const { return m_columns.value(index); }   // 未创建时返回空
+
+protected:
+    void resizeEvent(QResizeEvent *event) override;
+
+private slots:
+    void updateVisibleColumns();
+
+private:
+    static const int ColumnWidth = 320;
+    static const int ColumnSpacing = 10;
+    static const int ContentMargin = 10;
+    static const int KeepAhead = 2;          // 视口两侧各多保留的列数，滚动时不必现建
+
+    QWidget            *m_content;
+    QMap<int, QWidget*> m_columns;           // 分类下标 -> 已创建的列
+    ColumnFactory       m_factory;
+    int                 m_count = 0;
+};
+
+#endif // BUCKETSTRIP_H
@@ -4,12 +4,19 @@
 #include "previewwindow.h"
 #include "sizepreviewwindow.h"
 #include "timepreviewwindow.h"
+#include "filecatalog.h"
+#include "filenameindex.h"
+#include "treemapwidget.h"
+#include <QThreadPool>
 #include <QtAlgorithms>
+#include <limits>
 #include <QDir>
 #include <QtCharts>
 #include <QDateTime>
 #include <QDate>
 #include <QMessageBox>
+#include <QToolTip>
+#include <QCursor>
 
 #include <QFileInfo>
 #include <QDateTime>
@@ -24,7 +31,6 @@ classificationWindow::classificationWindow(const QString& Path, QWidget *parent)
     selectedPath = Path;
     resize(1000, 800);
     qDebug() << "selectedPath:" << selectedPath;
-    updateFileStatistics();
 
     ui->checkBox_smallKB->setChecked(false);
     is_smallKB_used = false;
@@ -35,26 +41,28 @@ classificationWindow::classificationWindow(const QString& Path, QWidget *parent)
     is_days_used = true;
     is_months_used = false;
     is_years_used = false;
+
+    initChart();
+    scanDirectory();
+    updateFileStatistics();
 }
 
 classificationWindow::~classificationWindow()
 {
+    if (m_nameIndex)
+        m_nameIndex->cancel();        // 后台任务持有自己的引用，取消后自行释放
     delete ui;
 }
 
 
-// 把 selectedPath 下所有文件都收集出来
-QList<QFileInfo> classificationWindow::collectAllFiles() const
-{
-    QDir dir(selectedPath);
-    return dir.entryInfoList(QDir::Files | QDir::NoDotAndDotDot |
-                                 QDir::Hidden | QDir::System | QDir::Readable,
-                             QDir::Name);      // 排序方式随意
-}
-
 // 初始化文件类型图表配置
 void classificationWindow::initChart()
 {
+    // 图表只创建一次，重复调用不再新建（视图换图表时不会释放旧图表）
+    if (fileTypeChart) {
+        return;
+    }
+
     // 创建图表和视图
     fileTypeChart = new QChart();
     fileTypeChartView = ui->fileTypeChartView;
@@ -62,8 +70,12 @@ void classificationWindow::initChart()
 
     // 设置抗锯齿
     fileTypeChartView->setRenderHint(QPainter::Antialiasing);
-    // 设置动画效果
-    fileTypeChart->setAnimationOptions(QChart::AllAnimations);
+    // 设置动画效果：只做系列动画，类型过多时在 updateChart() 中关闭
+    fileTypeChart->setAnimationOptions(QChart::SeriesAnimations);
+
+    // 饼图系列只创建一次，之后每次刷新就地更新扇形
+    fileTypeSeries = new QPieSeries();
+    fileTypeChart->addSeries(fileTypeSeries);
 
     // 设置图表边距
     fileTypeChart->setMargins(QMargins(10, 1, 10, 10));
@@ -73,83 +85,162 @@ void classificationWindow::initChart()
 
     // 隐藏图例
     fileTypeChart->legend()->hide();
+
+    // 文件大小分布直方图：系列和坐标轴只建一次，刷新时替换数值和分格标签
+    sizeHistogramChart = new QChart();
+    ui->sizeHistogramView->setChart(sizeHistogramChart);
+    sizeHistogramChart->setTitle("文件大小分布（按 2 的幂分格）");
+    sizeHistogramChart->setMargins(QMargins(4, 0, 4, 4));
+    sizeHistogramChart->legend()->hide();
+
+    sizeHistogramSet = new QBarSet("文件数");
+    QBarSeries *histogramSeries = new QBarSeries();
+    histogramSeries->setBarWidth(0.9);
+    histogramSeries->append(sizeHistogramSet);
+    sizeHistogramChart->addSeries(histogramSeries);
+
+    sizeHistogramAxisX = new QBarCategoryAxis();
+    sizeHistogramAxisX->setLabelsAngle(-90);
+    QFont axisFont = sizeHistogramAxisX->labelsFont();
+    axisFont.setPixelSize(9);
+    sizeHistogramAxisX->setLabelsFont(axisFont);
+    sizeHistogramChart->addAxis(sizeHistogramAxisX, Qt::AlignBottom);
+    histogramSeries->attachAxis(sizeHistogramAxisX);
+
+    sizeHistogramAxisY = new QValueAxis();
+    sizeHistogramAxisY->setLabelFormat("%d");
+    sizeHistogramAxisY->setLabelsFont(axisFont);
+    sizeHistogramChart->addAxis(sizeHistogramAxisY, Qt::AlignLeft);
+    histogramSeries->attachAxis(sizeHistogramAxisY);
+
+    // 悬停某格时提示区间和文件数，便于按实际分布设置体积阈值
+    connect(sizeHistogramSet, &QBarSet::hovered, this, [this](bool status, int index) {
+        if (!status) {
+            QToolTip::hideText();
+            return;
+        }
+        QToolTip::showText(QCursor::pos(), QString("%1\n%2 个文件")
+                                               .arg(sizeHistogramAxisX->at(index))
+                                               .arg(int(sizeHistogramSet->at(index))));
+    });
 }
 
 
-void classificationWindow::updateFileStatistics(){
+// 扫描目录，重建文件目录表（唯一一次磁盘枚举）
+void classificationWindow::scanDirectory()
+{
     //selectedPath：用户选择的文件夹路径
-    QDir dir(selectedPath);
-    if (!dir.exists()) {
-        return;
+    m_catalog = QSharedPointer<FileCatalog>::create(selectedPath);
+    m_catalog->scan();
+
+    // 文件名搜索索引在后台建立，建好之前预览窗口的搜索逐个比较
+    if (m_nameIndex)
+        m_nameIndex->cancel();
+    m_nameIndex = QSharedPointer<FileNameIndex>::create(m_catalog);
+    QSharedPointer<FileNameIndex> index = m_nameIndex;
+    QThreadPool::globalInstance()->start([index]() { index->build(); });
+}
+
+// 打开预览窗口；其中执行过分类（含撤销）时文件已变动，重新扫描，下次预览和统计面板都按新的目录内容
+void classificationWindow::showPreview(BucketPreviewWindow *window, const QMap<QString, QVector<int>> &buckets)
+{
+    window->setSearchIndex(m_nameIndex);
+    window->setBuckets(buckets);
+    window->exec();
+    const bool changed = window->filesChanged();
+    window->deleteLater();
+    if (changed) {
+        scanDirectory();
+        updateFileStatistics();
     }
-    // 统计文件总数
-    int totalFileCount = 0;
-    qint64 totalFileSize = 0;
-    // 用于存储文件类型及其数量的映射
-    QMap<QString, int> fileTypeCount;
-    // 用于存储文件大小分类及其数量和总大小的映射
-    QMap<QString, int> fileSizeCount;
-    QMap<QString, qint64> fileSizeTotalSize;
-
-    // 遍历目录下的文件
-    QFileInfoList fileList = dir.entryInfoList(QDir::Files | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System | QDir::Readable);
-    for (const QFileInfo &fileInfo : fileList) {
-        if (fileInfo.isFile()) {
-            totalFileCount++;
-            qint64 fileSize = fileInfo.size();
-            totalFileSize += fileSize;
-
-            // 统计文件类型
-            QString fileType = fileInfo.suffix();
-            if (fileTypeCount.contains(fileType)) {
-                fileTypeCount[fileType]++;
-            } else {
-                fileTypeCount[fileType] = 1;
-            }
+}
 
-            // 统计文件大小分类
-            QString sizeCategory = getFileSizeCategory(fileSize);
-            if (fileSizeCount.contains(sizeCategory)) {
-                fileSizeCount[sizeCategory]++;
-                fileSizeTotalSize[sizeCategory] += fileSize;
-            } else {
-                fileSizeCount[sizeCategory] = 1;
-                fileSizeTotalSize[sizeCategory] = fileSize;
-            }
-        }
+// 根据已缓存的统计结果刷新面板，不访问磁盘
+void classificationWindow::updateFileStatistics(){
+    if (!m_catalog) {
+        return;
     }
 
-    // 分组逻辑示例：将占比小于一定比例的文件类型合并为"其他"
+    // 后缀直方图的投影：合并小类 / 不合并
     QMap<QString, int> groupedFileTypeCount;
-    if (is_type1_activated) {
-        int thresholdCount = totalFileCount * 0.05; // 占比小于5%的归为其他
-        for (const QString &type : fileTypeCount.keys()) {
-            int count = fileTypeCount[type];
-            if (count >= thresholdCount) {
-                groupedFileTypeCount[type] = count;
-            } else {
-                if (!groupedFileTypeCount.contains("其他")) {
-                    groupedFileTypeCount["其他"] = 0;
-                }
-                groupedFileTypeCount["其他"] += count;
-            }
-        }
-    }
-    else if (is_type2_activated) {
-        for (const QString & type : fileTypeCount.keys()) {
-            int count = fileTypeCount[type];
-            groupedFileTypeCount[type] = count;
-        }
+    if (is_type1_activated || is_type2_activated) {
+        groupedFileTypeCount = m_catalog->groupedSuffixHistogram(is_type1_activated);
     }
 
+    int totalFileCount = m_catalog->size();
+
     // 更新数据显示
     ui->pathLabel->setWordWrap(true);
     ui->pathLabel->setText(QString("路径：%1").arg(selectedPath));
-    ui->totalFileCountLabel->setText(QString("文件总数：%1      文件类型数：%2      总大小：%3").arg(totalFileCount).arg(fileTypeCount.size()).arg(formatFileSize(totalFileSize)));
+    ui->totalFileCountLabel->setText(QString("文件总数：%1      文件类型数：%2      总大小：%3").arg(totalFileCount).arg(m_catalog->suffixHistogram().size()).arg(formatFileSize(m_catalog->totalSize())));
 
     // 绘制文件类型饼图
-    initChart();
-    updateChart(groupedFileTypeCount, totalFileCount);
+    updateChart(groupedFileTypeCount);
+
+    updateTimeWindowCounts();
+    updateSizeHistogram();
+}
+
+// 2 的幂字节数的简写：1B、512B、1K、4M、2G ...
+static QString powerOfTwoSize(int exponent)
+{
+    static const char *const units[] = {"B", "K", "M", "G", "T", "P", "E"};
+    return QString("%1%2").arg(qint64(1) << (exponent % 10)).arg(units[exponent / 10]);
+}
+
+// 刷新文件大小分布直方图：各格计数在扫描时已算好，这里只截掉两端的空格
+void classificationWindow::updateSizeHistogram()
+{
+    if (!m_catalog) {
+        return;
+    }
+
+    const QVector<int> &bins = m_catalog->sizeHistogram();
+    int first = 0, last = bins.size() - 1;
+    while (first < last && bins.at(first) == 0) ++first;
+    while (last > first && bins.at(last) == 0) --last;
+
+    QStringList categories;
+    int maxCount = 0;
+    sizeHistogramSet->remove(0, sizeHistogramSet->count());
+    for (int k = first; k <= last; ++k) {
+        // 第 k 格为 [2^(k-1), 2^k)，以下界标注
+        categories << (k == 0 ? QString("0") : QString("≥%1").arg(powerOfTwoSize(k - 1)));
+        sizeHistogramSet->append(bins.at(k));
+        maxCount = qMax(maxCount, bins.at(k));
+    }
+    sizeHistogramAxisX->setCategories(categories);
+    sizeHistogramAxisY->setRange(0, qMax(1, maxCount));
+}
+
+// 刷新天/月/年时间窗旁的文件数，判定顺序与 on_pushButton_time_clicked() 一致
+void classificationWindow::updateTimeWindowCounts()
+{
+    if (!m_catalog) {
+        return;
+    }
+
+    QDateTime curr = QDateTime::currentDateTime();
+    const qint64 thresholds[3] = {
+        curr.addDays(-ui->spinBox_days->value()).toMSecsSinceEpoch(),
+        curr.addDays(-ui->spinBox_months->value() * 30).toMSecsSinceEpoch(),
+        curr.addDays(-ui->spinBox_years->value() * 365).toMSecsSinceEpoch()
+    };
+    const bool used[3] = { is_days_used, is_months_used, is_years_used };
+    QLabel *labels[3] = { ui->label_daysCount, ui->label_monthsCount, ui->label_yearsCount };
+
+    // 排在前面且已勾选的时间窗会先"截走"文件，covered 为这些窗口并集的起点
+    qint64 covered = std::numeric_limits<qint64>::max();
+    for (int i = 0; i < 3; ++i) {
+        int inWindow = m_catalog->countModifiedSince(thresholds[i]);
+        if (used[i]) {
+            int taken = m_catalog->countModifiedSince(qMax(thresholds[i], covered));
+            labels[i]->setText(QString("→ %1 个文件").arg(inWindow - taken));
+            covered = qMin(covered, thresholds[i]);
+        } else {
+            labels[i]->setText(QString("（未勾选，窗口内 %1 个）").arg(inWindow));
+        }
+    }
 }
 
 // 获取文件大小分类
@@ -186,35 +277,58 @@ QString classificationWindow::formatFileSize(qint64 size)
     }
 }
 
-// 更新文件类型图表数据
-void classificationWindow::updateChart(const QMap<QString, int>& fileTypeCount, int totalCount)
-{
-    // 清除现有系列
-    fileTypeChart->removeAllSeries();
-
-    // 创建饼图系列
-    QPieSeries *series = new QPieSeries();
+// 饼图最多显示的扇形数，其余类型合并为"其他"；类型数超过动画阈值时关闭动画
+static const int MaxPieSlices = 12;
+static const int AnimatedTypeLimit = 50;
 
-    // 添加数据到系列
+// 更新文件类型图表数据：复用同一个系列和已有扇形，只改标签和数值
+void classificationWindow::updateChart(const QMap<QString, int>& fileTypeCount)
+{
+    // 按数量降序取前 MaxPieSlices 个，其余（连同投影里已有的"其他"）合并
+    QVector<QPair<int, QString>> entries;
+    entries.reserve(fileTypeCount.size());
+    int otherCount = 0;
     for (auto it = fileTypeCount.begin(); it != fileTypeCount.end(); ++it) {
-        QString fileType = it.key();
-        int count = it.value();
-        double percentage = (double)count / totalCount * 100;
+        if (it.key() == "其他")
+            otherCount += it.value();
+        else
+            entries.append(qMakePair(it.value(), it.key()));
+    }
+    std::sort(entries.begin(), entries.end(), [](const QPair<int, QString> &a, const QPair<int, QString> &b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+    for (int i = MaxPieSlices; i < entries.size(); ++i)
+        otherCount += entries.at(i).first;
+    if (entries.size() > MaxPieSlices)
+        entries.resize(MaxPieSlices);
+    if (otherCount > 0)
+        entries.append(qMakePair(otherCount, QString("其他")));
+
+    // 类型很多时动画逐个扇形插值，切换选项会明显卡顿
+    fileTypeChart->setAnimationOptions(fileTypeCount.size() > AnimatedTypeLimit ? QChart::NoAnimation
+                                                                                 : QChart::SeriesAnimations);
+
+    // 多余的扇形删除，不足的追加，其余就地更新
+    const QList<QPieSlice *> slices = fileTypeSeries->slices();
+    for (int i = entries.size(); i < slices.size(); ++i)
+        fileTypeSeries->remove(slices.at(i));
+
+    for (int i = 0; i < entries.size(); ++i) {
+        const QString label = QString("%1(%2个)").arg(entries.at(i).second).arg(entries.at(i).first);
+        if (i < slices.size()) {
+            slices.at(i)->setLabel(label);
+            slices.at(i)->setValue(entries.at(i).first);
+            continue;
+        }
 
         // 添加扇形
-        QPieSlice *slice = series->append(
-            QString("%1(%2个)").arg(fileType).arg(count),
-            count
-            );
+        QPieSlice *slice = fileTypeSeries->append(label, entries.at(i).first);
 
         // 强制显示完整标签
         slice->setLabelVisible(true);
         slice->setLabelPosition(QPieSlice::LabelOutside); // 标签位置在外部
         slice->setLabelArmLengthFactor(0.2);  // 调整标签延伸线长度
     }
-
-    // 将系列添加到图表
-    fileTypeChart->addSeries(series);
 }
 
 // 返回
@@ -226,19 +340,24 @@ void classificationWindow::on_backButton_clicked()
 // click"按文件类型分类"
 void classificationWindow::on_pushButton_clicked()
 {
-    const auto files = collectAllFiles();
-    int totalCount = files.size();
+    if (!m_catalog) {
+        return;
+    }
+    const FileCatalog &catalog = *m_catalog;
+    int totalCount = catalog.size();
 
     // 统计每种后缀出现的次数
     QMap<QString, int> suffixCount;
-    for (const QFileInfo &fi : files) {
-        QString suffix = fi.suffix().toLower();
+    QStringList suffixes;                         // 按文件 ID 缓存小写后缀
+    suffixes.reserve(totalCount);
+    for (int id = 0; id < totalCount; ++id) {
+        QString suffix = catalog.suffix(id).toLower();
         if (suffix.isEmpty()) suffix = "无后缀";
         suffixCount[suffix]++;
+        suffixes << suffix;
     }
 
-    QMap<QString, QStringList> fileData;          // <类型, 文件名列表>
-    QMap<QString, QString> folderMap;             // 文件夹名称映射
+    PreviewWindow::Buckets fileData;              // <类型, 文件 ID 列表>
 
     if (is_type1_activated) {
         // TYPE1 策略: 占比5%以下合并为"其他"
@@ -256,53 +375,37 @@ void classificationWindow::on_pushButton_clicked()
         }
 
         // 使用映射表归类文件
-        for (const QFileInfo &fi : files) {
-            QString suffix = fi.suffix().toLower();
-            if (suffix.isEmpty()) suffix = "无后缀";
-            QString category = suffixToCategory[suffix];
-
-            fileData[category] << fi.fileName();
-            folderMap[fi.fileName()] = category;
+        for (int id = 0; id < totalCount; ++id) {
+            fileData[suffixToCategory[suffixes.at(id)]] << id;
         }
     }
     else if (is_type2_activated) {
         // TYPE2 策略: 所有类型独立处理 (不合并)
-        for (const QFileInfo &fi : files) {
-            QString suffix = fi.suffix().toLower();
-            if (suffix.isEmpty()) suffix = "无后缀";
-
-            fileData[suffix] << fi.fileName();
-            folderMap[fi.fileName()] = suffix;
+        for (int id = 0; id < totalCount; ++id) {
+            fileData[suffixes.at(id)] << id;
         }
     }
 
     // 打开预览
-    PreviewWindow *w = new PreviewWindow(selectedPath,folderMap, this);
-    w->setFileData(fileData);
-    w->exec();
-    w->deleteLater();
+    showPreview(new PreviewWindow(m_catalog, this), fileData);
 }
 
 
 //click"按文件体积分类"
 void classificationWindow::on_pushButton_size_clicked()
 {
-    QMap<QString, QList<FileInfo>> fileSizeData;      // <区间, 文件信息列表>
-    QMap<QString, QString> folderMap;
+    if (!m_catalog) {
+        return;
+    }
 
-    const auto files = collectAllFiles();
-    for (const QFileInfo &fi : files)
+    SizePreviewWindow::Buckets fileSizeData;      // <区间, 文件 ID 列表>
+    for (int id = 0; id < m_catalog->size(); ++id)
     {
-        qint64 sz = fi.size();
-        QString cat = getFileSizeCategory(sz);        // 您已有的函数
-        fileSizeData[cat] << FileInfo(fi.fileName(), sz, fi.filePath());
-        folderMap[fi.fileName()] = cat;
+        QString cat = getFileSizeCategory(m_catalog->fileSize(id));
+        fileSizeData[cat] << id;
     }
 
-    SizePreviewWindow *w = new SizePreviewWindow(selectedPath, folderMap, this);
-    w->setFileData(fileSizeData);
-    w->exec();
-    w->deleteLater();
+    showPreview(new SizePreviewWindow(m_catalog, this), fileSizeData);
 }
 
 // 工具：返回所属时间段名称
@@ -325,21 +428,24 @@ static QString timeBucket(const QDateTime& mtime)
 
 void classificationWindow::on_pushButton_time_clicked()
 {
-    QMap<QString, QList<FileTimeInfo>> fileTimeData;  // <区间, 文件信息列表>
-    QMap<QString, QString> folderMap;
+    if (!m_catalog) {
+        return;
+    }
+
+    TimePreviewWindow::Buckets fileTimeData;      // <区间, 文件 ID 列表>
 
     int days = ui->spinBox_days->value();
     int months = ui->spinBox_months->value();
     int years = ui->spinBox_years->value();
 
-    const auto files = collectAllFiles();
-    for (const QFileInfo &fi : files)
+    QDateTime curr = QDateTime::currentDateTime();
+    QDateTime days_back = curr.addDays(-days);
+    QDateTime months_back = curr.addDays(-months * 30);
+    QDateTime years_back = curr.addDays(-years * 365);
+
+    for (int id = 0; id < m_catalog->size(); ++id)
     {
-        QDateTime file_time = fi.lastModified();
-        QDateTime curr = QDateTime::currentDateTime();
-        QDateTime days_back = curr.addDays(-days);
-        QDateTime months_back = curr.addDays(-months * 30);
-        QDateTime years_back = curr.addDays(-years * 365);
+        QDateTime file_time = QDateTime::fromMSecsSinceEpoch(m_catalog->modifiedMSecs(id));
 
         QString bucket;
 
@@ -363,18 +469,34 @@ void classificationWindow::on_pushButton_time_clicked()
             bucket = timeBucket(file_time);
         }
 
-        fileTimeData[bucket] << FileTimeInfo(fi.fileName(), fi.lastModified(), fi.filePath());
-        folderMap[fi.fileName()] = bucket;
+        fileTimeData[bucket] << id;
     }
 
     // 打开预览
-    TimePreviewWindow *w = new TimePreviewWindow(selectedPath,folderMap, this);
-    w->setFileData(fileTimeData);
-    w->exec();
-    w->deleteLater();
+    showPreview(new TimePreviewWindow(m_catalog, this), fileTimeData);
 }
 
 
+// click"查看空间占用图"
+void classificationWindow::on_pushButton_treemap_clicked()
+{
+    if (!m_catalog) {
+        return;
+    }
+
+    QDialog dialog(this);
+    dialog.setWindowTitle("空间占用图");
+    dialog.setWindowFlags(Qt::Dialog | Qt::WindowCloseButtonHint | Qt::WindowMaximizeButtonHint);
+    QVBoxLayout *layout = new QVBoxLayout(&dialog);
+    QLabel *hint = new QLabel("面积表示字节数，颜色表示文件类型。滚轮缩放，拖动平移，双击恢复全图。");
+    layout->addWidget(hint);
+    TreemapWidget *treemap = new TreemapWidget();
+    layout->addWidget(treemap, 1);
+    dialog.resize(900, 700);
+    treemap->setCatalog(m_catalog);
+    dialog.exec();
+}
+
 void classificationWindow::on_doubleSpinBox_smallKB_valueChanged(double value)
 {
     ui->doubleSpinBox_smallKB->setValue(value);
@@ -439,29 +561,35 @@ void classificationWindow::on_checkBox_type2_clicked(bool state)
 void classificationWindow::on_checkBox_days_clicked(bool state)
 {
     is_days_used = state;
+    updateTimeWindowCounts();
 }
 
 void classificationWindow::on_checkBox_months_clicked(bool state)
 {
     is_months_used = state;
+    updateTimeWindowCounts();
 }
 
 void classificationWindow::on_checkBox_years_clicked(bool state)
 {
     is_years_used = state;
+    updateTimeWindowCounts();
 }
 
 void classificationWindow::on_spinBox_days_valueChanged(int value)
 {
     ui->spinBox_days->setValue(value);
+    updateTimeWindowCounts();
 }
 
 void classificationWindow::on_spinBox_months_valueChanged(int value)
 {
     ui->spinBox_months->setValue(value);
+    updateTimeWindowCounts();
 }
 
 void classificationWindow::on_spinBox_years_valueChanged(int value)
 {
     ui->spinBox_years->setValue(value);
+    updateTimeWindowCounts();
 }
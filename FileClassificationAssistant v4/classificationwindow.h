@@ -8,6 +8,11 @@
 #include <QDirIterator>
 #include <QFileInfo>
 #include <QDateTime>
+#include <QSharedPointer>
+
+class FileCatalog;
+class FileNameIndex;
+class BucketPreviewWindow;
 
 namespace Ui {
 class classificationWindow;
@@ -24,11 +29,12 @@ public:
 private slots:
     void initChart();
     void updateFileStatistics();
-    void updateChart(const QMap<QString, int>& fileTypeCount, int totalCount);
+    void updateChart(const QMap<QString, int>& fileTypeCount);
     void on_backButton_clicked();
     void on_pushButton_clicked(); // "按文件类型分类"
     void on_pushButton_size_clicked(); // "按文件体积分类"
     void on_pushButton_time_clicked(); // "按文件修改时间分类"
+    void on_pushButton_treemap_clicked(); // "查看空间占用图"
 
     void on_doubleSpinBox_smallKB_valueChanged(double value); // 第一个文件大小区间
     void on_doubleSpinBox_smallMB_valueChanged(double value); // 第二个文件大小区间
@@ -55,15 +61,27 @@ private slots:
 private:
     QString getFileSizeCategory(qint64 fileSize);
     QString formatFileSize(qint64 size);
+    void updateTimeWindowCounts();                   // 刷新天/月/年时间窗旁的文件数
+    void updateSizeHistogram();                      // 刷新文件大小分布直方图
 
     Ui::classificationWindow *ui;
     QString selectedPath = ""; // 选择的文件目录路径
 
     // 文件类型图表相关
     QChartView *fileTypeChartView;
-    QChart *fileTypeChart;
+    QChart *fileTypeChart = nullptr;
+    QPieSeries *fileTypeSeries = nullptr;   // 唯一的饼图系列，归图表所有
+
+    // 文件大小分布（按 2 的幂分格）
+    QChart *sizeHistogramChart = nullptr;
+    QBarSet *sizeHistogramSet = nullptr;
+    QBarCategoryAxis *sizeHistogramAxisX = nullptr;
+    QValueAxis *sizeHistogramAxisY = nullptr;
 private:
-    QList<QFileInfo> collectAllFiles() const;   // 递归收集文件
+    void scanDirectory();                       // 扫描目录并重建文件目录表
+    void showPreview(BucketPreviewWindow *window, const QMap<QString, QVector<int>> &buckets);
+    QSharedPointer<FileCatalog> m_catalog;      // 扫描结果及派生统计，切换视图时只做投影
+    QSharedPointer<FileNameIndex> m_nameIndex;  // 文件名搜索索引，扫描后在后台建立
 
     bool is_smallKB_used;
     bool is_smallMB_used;
@@ -0,0 +1,486 @@
+// 执行日志：每组文件操作前先追加意图记录并落盘，程序异常退出后可据此回滚或补完
+//
+// 文件格式（UTF-8 文本，一行一条，字段以制表符分隔，路径中的 \ 制表符 换行 会转义）：
+//   FCAJ 1  <根目录>         文件头
+//   P  <计划文件>  <起点>    本次执行依据的计划文件及起始位置
+//   I  <类型>  <源>  <目标>  [R]  意图：即将执行的一项操作，R 表示替换已有的目标
+//   T  <原位置>  <回收站中的位置>  已移入回收站的文件（去重的源文件或被替换的旧目标）
+//   K  <位置>                检查点：计划中该位置之前的任务均已处理
+//   F  <源>                  续传前未能补完、保持原状并跳过的任务
+//   E                        执行正常结束
+// 意图在操作之前写入，回放时按文件实际所在位置判断每一项是否已经执行，因此无需逐项提交记录。
+// 续传时先按日志补完最后一个检查点之后记录过的意图，再从检查点处继续读计划并跳过这些文件。
+#include "executejournal.h"
+#include "moveengine.h"
+#include "moveplan.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QSet>
+#include <QHash>
+#include <QDateTime>
+#include <QCoreApplication>
+#include <QStandardPaths>
+#include <QDebug>
+#include <algorithm>
+
+#if defined(Q_OS_UNIX)
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(Q_OS_WIN)
+#include <io.h>
+#endif
+
+static const QByteArray JournalMagic = "FCAJ 1";
+
+static QByteArray escapeField(const QString &text)
+{
+    QByteArray out;
+    const QByteArray utf8 = text.toUtf8();
+    out.reserve(utf8.size());
+    for (char c : utf8) {
+        switch (c) {
+        case '\\': out += "\\\\"; break;
+        case '\t': out += "\\t";  break;
+        case '\n': out += "\\n";  break;
+        case '\r': out += "\\r";  break;
+        default:   out += c;
+        }
+    }
+    return out;
+}
+
+static QString unescapeField(const QByteArray &field)
+{
+    QByteArray out;
+    out.reserve(field.size());
+    for (int i = 0; i < field.size(); ++i) {
+        char c = field.at(i);
+        if (c == '\\' && i + 1 < field.size()) {
+            char n = field.at(++i);
+            c = n == 't' ? '\t' : n == 'n' ? '\n' : n == 'r' ? '\r' : n;
+        }
+        out += c;
+    }
+    return QString::fromUtf8(out);
+}
+
+// 把文件数据（不含无关元数据）刷到磁盘
+static bool syncDescriptor(int fd)
+{
+#if defined(Q_OS_LINUX)
+    return ::fdatasync(fd) == 0;
+#elif defined(Q_OS_UNIX)
+    return ::fsync(fd) == 0;
+#elif defined(Q_OS_WIN)
+    return ::_commit(fd) == 0;
+#else
+    Q_UNUSED(fd);
+    return true;
+#endif
+}
+
+ExecuteJournal::ExecuteJournal()
+{
+}
+
+ExecuteJournal::~ExecuteJournal()
+{
+    m_file.close();
+}
+
+QString ExecuteJournal::journalDir()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/journal";
+}
+
+bool ExecuteJournal::create(const QString &rootPath)
+{
+    const QString dir = journalDir();
+    if (!QDir().mkpath(dir))
+        return false;
+
+    const QString name = QString("run-%1-%2.journal")
+                             .arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss-zzz"))
+                             .arg(QCoreApplication::applicationPid());
+    m_file.setFileName(dir + "/" + name);
+    // 不经过 QFile 的缓冲，write 返回时数据已交给系统，落盘只差一次 fdatasync
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::NewOnly | QIODevice::Unbuffered))
+        return false;
+
+    const qint64 end = append(JournalMagic + "\t" + escapeField(rootPath) + "\n");
+    if (end < 0 || !syncUpTo(end)) {
+        discard();
+        return false;
+    }
+
+#if defined(Q_OS_UNIX)
+    // 新建的目录项本身也要落盘，否则崩溃后可能找不到日志
+    int dirFd = ::open(QFile::encodeName(dir).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd >= 0) {
+        ::fsync(dirFd);
+        ::close(dirFd);
+    }
+#endif
+    return true;
+}
+
+qint64 ExecuteJournal::append(const QByteArray &data)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_ok || !m_file.isOpen())
+        return -1;
+    if (m_file.write(data) != data.size()) {
+        m_ok = false;
+        qWarning() << "执行日志写入失败，后续操作不再记录：" << m_file.fileName();
+        return -1;
+    }
+    m_written += data.size();
+    return m_written;
+}
+
+bool ExecuteJournal::syncUpTo(qint64 offset)
+{
+    QMutexLocker locker(&m_mutex);
+    while (m_ok && m_durable < offset) {
+        if (m_syncing) {
+            // 已有线程在落盘：等它结束，它提交的范围可能已经覆盖本组
+            m_synced.wait(&m_mutex);
+            continue;
+        }
+        // 成为本轮提交者，把此刻已写入的所有组一次落盘
+        m_syncing = true;
+        const qint64 target = m_written;
+        const int fd = m_file.handle();
+        locker.unlock();
+        const bool ok = syncDescriptor(fd);
+        locker.relock();
+        m_syncing = false;
+        if (ok)
+            m_durable = target;
+        else
+            m_ok = false;
+        m_synced.wakeAll();
+    }
+    return m_durable >= offset;
+}
+
+bool ExecuteJournal::logIntents(const QVector<Entry> &entries)
+{
+    if (entries.isEmpty())
+        return true;
+
+    QByteArray data;
+    for (const Entry &entry : entries) {
+        data += "I\t" + QByteArray::number(int(entry.kind)) + "\t"
+                + escapeField(entry.srcPath) + "\t" + escapeField(entry.dstPath)
+                + (entry.replace ? "\tR\n" : "\n");
+    }
+    const qint64 end = append(data);
+    return end >= 0 && syncUpTo(end);
+}
+
+bool ExecuteJournal::logTrashed(const QString &path, const QString &trashPath)
+{
+    if (trashPath.isEmpty())
+        return false;                 // 系统没有给出回收站中的位置，回滚时只能报告无法放回
+    const qint64 end = append("T\t" + escapeField(path) + "\t" + escapeField(trashPath) + "\n");
+    return end >= 0 && syncUpTo(end);
+}
+
+void ExecuteJournal::markFinished()
+{
+    const qint64 end = append("E\n");
+    if (end >= 0)
+        syncUpTo(end);
+}
+
+void ExecuteJournal::recordPlan(const QString &planPath, int cursor)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_planPath = planPath;
+    }
+    const qint64 end = append("P\t" + escapeField(planPath) + "\t" + QByteArray::number(cursor) + "\n");
+    if (end >= 0)
+        syncUpTo(end);
+}
+
+void ExecuteJournal::recordFailed(const QStringList &srcPaths)
+{
+    if (srcPaths.isEmpty())
+        return;
+    QByteArray data;
+    for (const QString &path : srcPaths)
+        data += "F\t" + escapeField(path) + "\n";
+    const qint64 end = append(data);
+    if (end >= 0)
+        syncUpTo(end);
+}
+
+void ExecuteJournal::checkpoint(int cursor)
+{
+    const qint64 end = append("K\t" + QByteArray::number(cursor) + "\n");
+    if (end >= 0)
+        syncUpTo(end);
+}
+
+QString ExecuteJournal::companionPlanPath() const
+{
+    QString path = m_file.fileName();
+    path.chop(int(qstrlen(".journal")));
+    return path + ".plan";
+}
+
+bool ExecuteJournal::ownsPlan(const QString &planPath)
+{
+    return QFileInfo(planPath).absolutePath() == QFileInfo(journalDir()).absoluteFilePath();
+}
+
+void ExecuteJournal::discard()
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_file.fileName().isEmpty())
+        return;
+    m_file.close();
+    QFile::remove(m_file.fileName());
+    if (!m_planPath.isEmpty() && ownsPlan(m_planPath))
+        QFile::remove(m_planPath);
+    m_file.setFileName(QString());
+    m_planPath.clear();
+    m_ok = false;
+}
+
+// ---------- 启动时恢复 ----------
+
+// 日志的全部内容
+struct JournalContents {
+    QString                        rootPath;
+    QVector<ExecuteJournal::Entry> entries;
+    QHash<QString, QString>        trashed;               // 原位置 -> 回收站中的位置
+    bool                           finished = false;
+    QString                        planPath;
+    int                            checkpoint = -1;       // 最后一个检查点，-1 表示没有
+    int                            sinceCheckpoint = 0;   // 最后一个检查点之后的第一条意图下标
+    int                            failedTasks = 0;       // F 记录条数
+};
+
+// 读出日志内容；文件头不对时返回 false
+static bool readJournal(const QString &path, JournalContents *contents)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    bool headerSeen = false;
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine();
+        if (!line.endsWith('\n'))
+            break;                       // 崩溃时写了一半的尾行：其对应操作尚未开始
+        line.chop(1);
+        const QList<QByteArray> fields = line.split('\t');
+
+        if (!headerSeen) {
+            if (fields.size() < 2 || fields.at(0) != JournalMagic)
+                return false;
+            contents->rootPath = unescapeField(fields.at(1));
+            headerSeen = true;
+        } else if (fields.at(0) == "I" && (fields.size() == 4 || fields.size() == 5)) {
+            ExecuteJournal::Entry entry;
+            entry.kind = ExecuteRecord::Kind(fields.at(1).toInt());
+            entry.srcPath = unescapeField(fields.at(2));
+            entry.dstPath = unescapeField(fields.at(3));
+            entry.replace = fields.size() == 5 && fields.at(4) == "R";
+            contents->entries << entry;
+        } else if (fields.at(0) == "T" && fields.size() == 3) {
+            contents->trashed.insert(unescapeField(fields.at(1)), unescapeField(fields.at(2)));
+        } else if (fields.at(0) == "P" && fields.size() == 3) {
+            contents->planPath = unescapeField(fields.at(1));
+            contents->checkpoint = fields.at(2).toInt();
+            contents->sinceCheckpoint = contents->entries.size();
+        } else if (fields.at(0) == "K" && fields.size() == 2) {
+            contents->checkpoint = fields.at(1).toInt();
+            contents->sinceCheckpoint = contents->entries.size();
+        } else if (fields.at(0) == "F" && fields.size() == 2) {
+            ++contents->failedTasks;
+        } else if (fields.at(0) == "E") {
+            contents->finished = true;
+        }
+    }
+    return headerSeen;
+}
+
+QStringList ExecuteJournal::pendingJournals()
+{
+    QDir dir(journalDir());
+    QStringList paths;
+    const QStringList names = dir.entryList(QStringList() << "*.journal", QDir::Files, QDir::Name);
+    for (const QString &name : names)
+        paths << dir.filePath(name);
+    return paths;
+}
+
+QString ExecuteJournal::describe(const QString &journalPath)
+{
+    JournalContents contents;
+    if (!readJournal(journalPath, &contents))
+        return QString("无法识别的日志文件：%1").arg(journalPath);
+
+    QString text = QString("目录：%1\n记录的操作：%2 项\n状态：%3")
+                       .arg(contents.rootPath)
+                       .arg(contents.entries.size())
+                       .arg(contents.finished ? "已执行完毕，但未确认或撤销" : "执行过程中被中断");
+    if (!contents.finished && contents.checkpoint >= 0)
+        text += QString("\n断点：计划第 %1 项").arg(contents.checkpoint);
+    if (contents.failedTasks > 0)
+        text += QString("\n续传时跳过的失败任务：%1 项").arg(contents.failedTasks);
+    return text;
+}
+
+void ExecuteJournal::remove(const QString &journalPath, bool keepPlan)
+{
+    JournalContents contents;
+    readJournal(journalPath, &contents);
+    QFile::remove(journalPath);
+    if (!keepPlan && !contents.planPath.isEmpty() && ownsPlan(contents.planPath))
+        QFile::remove(contents.planPath);
+}
+
+bool ExecuteJournal::resumePoint(const QString &journalPath, ResumePoint *point)
+{
+    JournalContents contents;
+    if (!readJournal(journalPath, &contents) || contents.finished || contents.planPath.isEmpty())
+        return false;
+
+    // 计划文件须完整可读：条数不足检查点说明写计划时崩溃而计划被截断，续传会悄悄漏掉任务
+    MovePlanReader plan;
+    if (!plan.open(contents.planPath) || plan.total() < contents.checkpoint)
+        return false;
+
+    point->rootPath = contents.rootPath;
+    point->planPath = contents.planPath;
+    point->cursor = qMax(0, contents.checkpoint);
+    point->handledSources.clear();
+    for (int i = contents.sinceCheckpoint; i < contents.entries.size(); ++i)
+        point->handledSources.insert(contents.entries.at(i).srcPath);
+    return true;
+}
+
+int ExecuteJournal::replay(const QString &journalPath, ReplayAction action, int *failed,
+                           bool keepPlan, QStringList *failedSources)
+{
+    JournalContents contents;
+    int failures = 0;
+    int handled = 0;
+    auto fail = [&](const Entry &entry) {
+        ++failures;
+        if (failedSources) *failedSources << entry.srcPath;
+    };
+
+    if (!readJournal(journalPath, &contents)) {
+        if (failed) *failed = 1;
+        return 0;
+    }
+    const QString &rootPath = contents.rootPath;
+    QVector<Entry> &entries = contents.entries;
+
+    // 回滚时倒序处理，与撤销顺序一致
+    if (action == Rollback)
+        std::reverse(entries.begin(), entries.end());
+
+    QSet<QString> touchedDirs;
+    MoveEngine engine(rootPath);                 // 补完链接时沿用执行时的建链方式，回收站中的文件经它放回
+    for (const Entry &entry : std::as_const(entries)) {
+        const QFileInfo dstInfo(entry.dstPath);
+        const bool srcExists = QFileInfo::exists(entry.srcPath);
+        const bool dstExists = dstInfo.exists();
+        touchedDirs.insert(dstInfo.absolutePath());
+
+        // 复制（含跨文件系统移动）过程中崩溃留下的临时文件
+        if (entry.kind == ExecuteRecord::Copied || entry.kind == ExecuteRecord::Moved)
+            QFile::remove(dstInfo.absolutePath() + "/" + MoveEngine::partFileName(dstInfo.fileName()));
+
+        if (entry.kind == ExecuteRecord::Deduped) {
+            if (action == Rollback) {
+                // 重复的源文件已移入回收站：按记下的位置放回；位置没记下（或已被清空）时
+                // 计为失败并保留日志，由用户从回收站找回
+                if (srcExists) continue;             // 尚未移走
+                const QString trashPath = contents.trashed.value(entry.srcPath);
+                QDir().mkpath(QFileInfo(entry.srcPath).absolutePath());
+                if (!trashPath.isEmpty() && engine.restoreFromTrash(trashPath, entry.srcPath)) ++handled;
+                else fail(entry);
+            } else if (srcExists && dstExists) {
+                // 补完时目标仍在才把源文件移走
+                if (QFile::moveToTrash(entry.srcPath)) ++handled;
+                else fail(entry);
+            }
+            continue;
+        }
+
+        if (action == Rollback) {
+            bool undone = true;                      // 目标处已不再是本次放入的文件
+            if (entry.kind == ExecuteRecord::Copied || entry.kind == ExecuteRecord::Linked) {
+                if (dstExists) {
+                    // 原文件还在才能删副本（或链接），否则它就是唯一的一份
+                    undone = srcExists && QFile::remove(entry.dstPath);
+                    if (undone) ++handled;
+                    else fail(entry);
+                }
+            } else if (!srcExists) {
+                if (dstExists) {
+                    QDir().mkpath(QFileInfo(entry.srcPath).absolutePath());
+                    undone = QFile::rename(entry.dstPath, entry.srcPath);
+                    if (undone) ++handled;
+                    else fail(entry);
+                } else {
+                    undone = false;
+                    fail(entry);                     // 两处都找不到
+                }
+            }
+            // 被替换的旧目标从回收站放回；替换前已移走却没记下位置时同样保留日志
+            if (undone && entry.replace && !QFileInfo::exists(entry.dstPath)) {
+                const QString trashPath = contents.trashed.value(entry.dstPath);
+                if (!trashPath.isEmpty() && engine.restoreFromTrash(trashPath, entry.dstPath)) ++handled;
+                else fail(entry);
+            }
+        } else {
+            if (!srcExists) continue;                // 已执行过（或源文件已不在）
+            if (entry.kind == ExecuteRecord::Copied) {
+                if (dstExists) continue;             // 已复制，或替换时的旧文件未移走（保守起见不动）
+                QDir().mkpath(dstInfo.absolutePath());
+                if (QFile::copy(entry.srcPath, entry.dstPath)) ++handled;
+                else fail(entry);
+            } else if (entry.kind == ExecuteRecord::Linked) {
+                if (dstExists) continue;
+                const QString subDir = QDir(rootPath).relativeFilePath(dstInfo.absolutePath());
+                if (!engine.linkInto(entry.srcPath, subDir, dstInfo.fileName()).isEmpty()) ++handled;
+                else fail(entry);
+            } else {
+                // 只有记为替换的意图才把已有目标移入回收站；否则目标处是无关的文件，不动它并保留日志
+                QDir().mkpath(dstInfo.absolutePath());
+                if (dstExists && (!entry.replace || !QFile::moveToTrash(entry.dstPath))) {
+                    fail(entry);
+                    continue;
+                }
+                if (QFile::rename(entry.srcPath, entry.dstPath)) ++handled;
+                else fail(entry);
+            }
+        }
+    }
+
+    // 回滚后清理空出来的分类目录（非空时 rmdir 自然失败）
+    if (action == Rollback) {
+        QStringList dirs = touchedDirs.values();
+        std::sort(dirs.begin(), dirs.end(), [](const QString &a, const QString &b) {
+            return a.size() > b.size();
+        });
+        for (const QString &dir : std::as_const(dirs)) {
+            if (QDir::cleanPath(dir) != QDir::cleanPath(rootPath))
+                QDir().rmdir(dir);
+        }
+    }
+
+    if (failures == 0)
+        remove(journalPath, keepPlan);
+    if (failed) *failed = failures;
+    return handled;
+}
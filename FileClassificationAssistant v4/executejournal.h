@@ -0,0 +1,92 @@
+// 执行日志：每组文件操作前先追加意图记录并落盘，程序异常退出后可据此回滚、补完或从断点续传
+#ifndef EXECUTEJOURNAL_H
+#define EXECUTEJOURNAL_H
+
+#include "moveexecutor.h"
+#include <QFile>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QVector>
+#include <QSet>
+#include <QStringList>
+
+class ExecuteJournal
+{
+public:
+    // 一条意图：kind 类型的操作将把 srcPath 放到 dstPath；replace 表示先把已有的目标移入回收站
+    struct Entry {
+        ExecuteRecord::Kind kind = ExecuteRecord::Moved;
+        QString srcPath;
+        QString dstPath;
+        bool    replace = false;
+    };
+
+    enum ReplayAction { Rollback, Complete };
+
+    // 断点：从计划的第 cursor 项继续，handledSources 中的文件已由日志补完，需跳过
+    struct ResumePoint {
+        QString       rootPath;
+        QString       planPath;
+        int           cursor = 0;
+        QSet<QString> handledSources;
+    };
+
+    ExecuteJournal();
+    ~ExecuteJournal();
+
+    ExecuteJournal(const ExecuteJournal &) = delete;
+    ExecuteJournal &operator=(const ExecuteJournal &) = delete;
+
+    // 在应用数据目录下新建日志文件
+    bool create(const QString &rootPath);
+
+    // 追加一组意图并确保落盘后返回；可从多个工作线程同时调用，
+    // 并发到达的组共用一次 fdatasync（组提交）
+    bool logIntents(const QVector<Entry> &entries);
+
+    // path 已移入回收站，位于 trashPath（去重的源文件或被替换的旧目标）；落盘后返回，
+    // 回滚时据此放回。只在冲突时发生，逐条落盘
+    bool logTrashed(const QString &path, const QString &trashPath);
+
+    // 记录本次执行所依据的计划文件及起始位置；计划位于日志目录下时随日志一起删除
+    void recordPlan(const QString &planPath, int cursor);
+    // 检查点：计划中 cursor 之前的任务均已处理完毕
+    void checkpoint(int cursor);
+    // 续传前未能补完的任务：保持原状并跳过，记下以便查看
+    void recordFailed(const QStringList &srcPaths);
+    // 执行器自动写出计划文件时使用的路径（与日志同名）
+    QString companionPlanPath() const;
+
+    void markFinished();              // 执行正常结束（仍保留日志以便撤销）
+    void discard();                   // 关闭并删除日志：结果已确认或已撤销
+
+    // ---------- 启动时恢复 ----------
+    static QStringList pendingJournals();                     // 上次未清理的日志
+    static QString describe(const QString &journalPath);      // 供提示框显示的摘要
+    // 按日志回滚或补完，返回处理的文件数；全部成功时删除日志（keepPlan 为 false 时连同计划文件）。
+    // failedSources 收集未能处理的意图的源文件
+    static int replay(const QString &journalPath, ReplayAction action, int *failed = nullptr,
+                      bool keepPlan = false, QStringList *failedSources = nullptr);
+    // 删除日志（keepPlan 为 false 时连同日志目录管理的计划文件）
+    static void remove(const QString &journalPath, bool keepPlan = false);
+    // 中断的执行若有计划文件和检查点，可从断点续传
+    static bool resumePoint(const QString &journalPath, ResumePoint *point);
+    // 计划文件由日志目录管理（执行器自动写出）时，随日志一起清理
+    static bool ownsPlan(const QString &planPath);
+
+private:
+    static QString journalDir();
+    qint64 append(const QByteArray &data);     // 写入并返回写入后的文件末尾偏移
+    bool syncUpTo(qint64 offset);
+
+    QFile          m_file;
+    QMutex         m_mutex;
+    QWaitCondition m_synced;
+    qint64         m_written = 0;      // 已写入（未必落盘）的末尾偏移
+    qint64         m_durable = 0;      // 已确认落盘的末尾偏移
+    bool           m_syncing = false;  // 是否有线程正在 fdatasync
+    bool           m_ok = true;
+    QString        m_planPath;         // 本次执行依据的计划文件
+};
+
+#endif // EXECUTEJOURNAL_H
@@ -0,0 +1,76 @@
+// 执行选项栏（执行方式、并发数等），嵌入各预览窗口底部
+#include "executeoptionswidget.h"
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QComboBox>
+#include <QSpinBox>
+#include <QCheckBox>
+#include <QThread>
+
+ExecuteOptionsWidget::ExecuteOptionsWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    QHBoxLayout *layout = new QHBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(6);
+
+    // 执行方式
+    m_modeCombo = new QComboBox(this);
+    m_modeCombo->addItem("移动文件", ExecuteOptions::Move);
+    m_modeCombo->addItem("复制文件（保留原目录）", ExecuteOptions::Copy);
+    m_modeCombo->addItem("建立链接（虚拟分类）", ExecuteOptions::Link);
+    m_modeCombo->setToolTip("复制模式下优先使用引用链接（reflink），不支持时在内核中直接复制；\n"
+                            "链接模式只在分类目录中建硬链接（跨磁盘时为符号链接），原文件不动，删除分类目录即可还原");
+
+    // 目标已有同名文件时的处理方式
+    m_conflictCombo = new QComboBox(this);
+    m_conflictCombo->addItem("自动改名", ExecuteOptions::RenameWithSuffix);
+    m_conflictCombo->addItem("跳过", ExecuteOptions::SkipExisting);
+    m_conflictCombo->addItem("保留较新", ExecuteOptions::KeepNewer);
+    m_conflictCombo->addItem("相同则去重", ExecuteOptions::DedupeIdentical);
+    m_conflictCombo->setToolTip("被替换或去重的文件会移入回收站，撤销时放回");
+
+    // 并发线程数
+    m_workerSpin = new QSpinBox(this);
+    m_workerSpin->setRange(1, 64);
+    m_workerSpin->setValue(qBound(1, QThread::idealThreadCount(), 64));
+
+    // 复制在途上限
+    m_bufferSpin = new QSpinBox(this);
+    m_bufferSpin->setRange(16, 8192);
+    m_bufferSpin->setSingleStep(64);
+    m_bufferSpin->setValue(256);
+    m_bufferSpin->setSuffix(" MB");
+    m_bufferSpin->setToolTip("复制模式下同时在途的最大数据量，避免大批量复制占满页缓存");
+
+    // 演练：只写出计划文件，之后可从主窗口菜单按计划执行
+    m_dryRunCheck = new QCheckBox("仅生成计划", this);
+    m_dryRunCheck->setToolTip("不移动任何文件，只把每个文件的去向及冲突写入计划文件，供审阅后再执行");
+
+    layout->addWidget(new QLabel("执行方式:", this));
+    layout->addWidget(m_modeCombo);
+    layout->addWidget(new QLabel("重名:", this));
+    layout->addWidget(m_conflictCombo);
+    layout->addWidget(new QLabel("并发:", this));
+    layout->addWidget(m_workerSpin);
+    layout->addWidget(new QLabel("复制缓冲:", this));
+    layout->addWidget(m_bufferSpin);
+    layout->addWidget(m_dryRunCheck);
+
+    // 缓冲上限只对复制模式有意义
+    m_bufferSpin->setEnabled(false);
+    connect(m_modeCombo, &QComboBox::currentIndexChanged, this, [this]() {
+        m_bufferSpin->setEnabled(m_modeCombo->currentData().toInt() == ExecuteOptions::Copy);
+    });
+}
+
+ExecuteOptions ExecuteOptionsWidget::options() const
+{
+    ExecuteOptions options;
+    options.mode = static_cast<ExecuteOptions::Mode>(m_modeCombo->currentData().toInt());
+    options.conflictPolicy = static_cast<ExecuteOptions::ConflictPolicy>(m_conflictCombo->currentData().toInt());
+    options.workerCount = m_workerSpin->value();
+    options.inFlightBytes = qint64(m_bufferSpin->value()) * 1024 * 1024;
+    options.dryRun = m_dryRunCheck->isChecked();
+    return options;
+}
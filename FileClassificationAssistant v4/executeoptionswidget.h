@@ -0,0 +1,29 @@
+// 执行选项栏（执行方式、并发数等），嵌入各预览窗口底部
+#ifndef EXECUTEOPTIONSWIDGET_H
+#define EXECUTEOPTIONSWIDGET_H
+
+#include <QWidget>
+#include "moveexecutor.h"
+
+class QComboBox;
+class QSpinBox;
+class QCheckBox;
+
+class ExecuteOptionsWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit ExecuteOptionsWidget(QWidget *parent = nullptr);
+
+    // 根据当前界面选择生成执行选项
+    ExecuteOptions options() const;
+
+private:
+    QComboBox *m_modeCombo;           // 移动 / 复制
+    QComboBox *m_conflictCombo;       // 重名处理方式
+    QSpinBox  *m_workerSpin;          // 并发线程数
+    QSpinBox  *m_bufferSpin;          // 复制在途上限（MB）
+    QCheckBox *m_dryRunCheck;         // 只生成执行计划
+};
+
+#endif // EXECUTEOPTIONSWIDGET_H
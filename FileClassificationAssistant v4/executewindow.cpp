@@ -1,9 +1,17 @@
 // 执行分类窗口（进度条、撤销按钮等）
 #include "executewindow.h"
+#include "executejournal.h"
+#include "moveengine.h"
+#include "moveplan.h"
 #include <QDir>
 #include <QFile>
+#include <QHash>
+#include <QSet>
+#include <QThreadPool>
 #include <QMessageBox>
 #include <QDateTime>
+#include <QtMath>
+#include <algorithm>
 
 
 static QString sizeCategory(qint64 s)
@@ -29,23 +37,35 @@ static QString timeCategory(const QDateTime& mt)
 ExecuteWindow::ExecuteWindow(const QString &rootPath,
                              const QList<QFileInfo> &files,
                              const QMap<QString, QString> &floderMap,
-                             QWidget *parent)
+                             QWidget *parent,
+                             const ExecuteOptions &options)
     : QDialog(parent),
     mainLayout(nullptr),
     buttonLayout(nullptr),
     titleLabel(nullptr),
     statusLabel(nullptr),
+    currentFileLabel(nullptr),
     progressBar(nullptr),
     finishButton(nullptr),
     undoButton(nullptr),
+    pauseButton(nullptr),
+    workerThread(nullptr),
+    executor(nullptr),
+    journal(nullptr),
     progressTimer(nullptr),
+    lastSampleMs(0),
+    lastSampleDone(0),
+    lastSampleBytes(0),
+    filesPerSec(0),
+    bytesPerSec(0),
     currentProgress(0),
     isProcessing(false),
     isFinished(false),
+    isPaused(false),
     rootDir(rootPath),
     fileList(files),
     floderNameMap(floderMap),
-    currentIndex(0)
+    executeOptions(options)
 {
     setupUI();
     startFileClassification();
@@ -54,16 +74,17 @@ ExecuteWindow::ExecuteWindow(const QString &rootPath,
 
 ExecuteWindow::~ExecuteWindow()
 {
-    if (progressTimer) {
-        progressTimer->stop();
-        delete progressTimer;
-    }
+    if (isProcessing)
+        interruptKeepingJournal();
+    stopWorker();
+    // 窗口正常关闭，当前文件状态即为用户接受的结果
+    discardJournal();
 }
 
 void ExecuteWindow::setupUI()
 {
     setWindowTitle("文件分类执行中...");
-    setFixedSize(400, 200);
+    setFixedSize(420, 230);
     setModal(true);
 
     // 主布局
@@ -72,7 +93,10 @@ void ExecuteWindow::setupUI()
     mainLayout->setContentsMargins(20, 20, 20, 20);
 
     // 标题标签
-    titleLabel = new QLabel("正在执行文件分类处理", this);
+    titleLabel = new QLabel(executeOptions.dryRun ? "正在生成执行计划"
+                            : executeOptions.mode == ExecuteOptions::Copy ? "正在复制文件到分类目录"
+                            : executeOptions.mode == ExecuteOptions::Link ? "正在建立分类链接"
+                                                                           : "正在执行文件分类处理", this);
     titleLabel->setAlignment(Qt::AlignCenter);
     titleLabel->setStyleSheet("QLabel { font-size: 16px; font-weight: bold; color: #2c3e50; }");
     mainLayout->addWidget(titleLabel);
@@ -83,6 +107,12 @@ void ExecuteWindow::setupUI()
     statusLabel->setStyleSheet("QLabel { font-size: 12px; color: #7f8c8d; }");
     mainLayout->addWidget(statusLabel);
 
+    // 当前文件标签
+    currentFileLabel = new QLabel(this);
+    currentFileLabel->setAlignment(Qt::AlignCenter);
+    currentFileLabel->setStyleSheet("QLabel { font-size: 11px; color: #95a5a6; }");
+    mainLayout->addWidget(currentFileLabel);
+
     // 进度条
     progressBar = new QProgressBar(this);
     progressBar->setRange(0, 100);
@@ -145,81 +175,223 @@ void ExecuteWindow::setupUI()
         );
     connect(undoButton, &QPushButton::clicked, this, &ExecuteWindow::on_undoButton_clicked);
 
+    // 暂停按钮（演练很快，不提供）
+    pauseButton = new QPushButton("暂停", this);
+    pauseButton->setVisible(!executeOptions.dryRun);
+    pauseButton->setStyleSheet(
+        "QPushButton {"
+        "    background-color: #f39c12;"
+        "    color: white;"
+        "    border: none;"
+        "    padding: 8px 16px;"
+        "    border-radius: 4px;"
+        "    font-weight: bold;"
+        "}"
+        "QPushButton:hover {"
+        "    background-color: #e67e22;"
+        "}"
+        "QPushButton:disabled {"
+        "    background-color: #95a5a6;"
+        "    color: #7f8c8d;"
+        "}"
+        );
+    connect(pauseButton, &QPushButton::clicked, this, &ExecuteWindow::on_pauseButton_clicked);
+
     buttonLayout->addStretch();
     buttonLayout->addWidget(finishButton);
+    buttonLayout->addWidget(pauseButton);
     buttonLayout->addWidget(undoButton);
     buttonLayout->addStretch();
 
     mainLayout->addLayout(buttonLayout);
-
-    // 创建定时器
-    progressTimer = new QTimer(this);
-    connect(progressTimer, &QTimer::timeout, this, &ExecuteWindow::updateProgress);
 }
 
 void ExecuteWindow::startFileClassification()
 {
     isProcessing = true;
     isFinished   = false;
-    currentIndex = 0;
     currentProgress = 0;
 
     statusLabel->setText("正在处理文件...");
     progressBar->setValue(0);
     finishButton->setEnabled(false);
 
+    if (!executeOptions.dryRun && !executeOptions.planPath.isEmpty()) {
+        // 按计划文件执行：任务从文件中分块读取，不整体载入内存
+        MovePlanReader *reader = new MovePlanReader;
+        if (!reader->open(executeOptions.planPath)) {
+            // 计划文件丢失或损坏：不能当作空计划“成功”执行
+            delete reader;
+            isProcessing = false;
+            statusLabel->setText("执行计划无法读取");
+            QMessageBox::warning(this, "无法执行",
+                                 "执行计划文件丢失或格式不正确，未执行任何操作：\n" + executeOptions.planPath);
+            QTimer::singleShot(0, this, &ExecuteWindow::reject);
+            return;
+        }
+        if (executeOptions.planCursor > 0 || !executeOptions.planSkip.isEmpty())
+            reader->resumeFrom(executeOptions.planCursor, executeOptions.planSkip);
+        executor = new MoveExecutor(reader, rootDir, executeOptions);
+    } else {
+        executor = new MoveExecutor(rootDir, fileList, floderNameMap, executeOptions);
+    }
+
+    // 移动在工作线程中成批进行，界面只接收节流后的进度
+    workerThread = new QThread(this);
+
+    // 日志建不起来（如应用数据目录不可写）时照常执行，只是失去崩溃恢复能力；演练不动文件，无需日志
+    if (!executeOptions.dryRun) {
+        journal = new ExecuteJournal;
+        if (!journal->create(rootDir)) {
+            delete journal;
+            journal = nullptr;
+        } else {
+            journal->recordFailed(executeOptions.planFailed);
+        }
+    }
+    executor->setJournal(journal);
+    executor->moveToThread(workerThread);
+    connect(workerThread, &QThread::started, executor, &MoveExecutor::run);
+    connect(executor, &MoveExecutor::finished, this, &ExecuteWindow::onProcessFinished);
+    runTimer.start();
+    lastSampleMs = 0;
+    lastSampleDone = 0;
+    lastSampleBytes = 0;
+    filesPerSec = 0;
+    bytesPerSec = 0;
     if (!progressTimer) {
         progressTimer = new QTimer(this);
-        connect(progressTimer, &QTimer::timeout,
-                this, &ExecuteWindow::updateProgress);
+        progressTimer->setInterval(ProgressSampleMs);
+        connect(progressTimer, &QTimer::timeout, this, &ExecuteWindow::sampleProgress);
     }
-    progressTimer->start(20);          // 每 20ms 处理一个文件
+    progressTimer->start();
+    workerThread->start();
+}
+
+void ExecuteWindow::stopWorker()
+{
+    if (!workerThread) return;
+
+    if (progressTimer) progressTimer->stop();
+    workerThread->quit();
+    workerThread->wait();
+    history << executor->history();
+
+    delete executor;
+    executor = nullptr;
+    delete workerThread;
+    workerThread = nullptr;
 }
 
 
-void ExecuteWindow::updateProgress()
+// 按固定频率采样：无论每秒处理多少文件，界面每次只刷新一次
+void ExecuteWindow::sampleProgress()
 {
-    if (!isProcessing) return;
+    if (!isProcessing || !executor) return;
+
+    const ExecuteProgress progress = executor->progress();
+    if (progress.total <= 0) return;
+
+    // 速率取指数滑动平均（时间常数约 3 秒），剩余时间随之平稳变化
+    const qint64 nowMs = runTimer.elapsed();
+    const double dt = (nowMs - lastSampleMs) / 1000.0;
+    if (dt > 0) {
+        const double alpha = 1.0 - qExp(-dt / RateTimeConstantSec);
+        const double files = (progress.done - lastSampleDone) / dt;
+        const double bytes = (progress.bytes - lastSampleBytes) / dt;
+        const bool first = lastSampleMs == 0;
+        filesPerSec = first ? files : filesPerSec + alpha * (files - filesPerSec);
+        bytesPerSec = first ? bytes : bytesPerSec + alpha * (bytes - bytesPerSec);
+        lastSampleMs = nowMs;
+        lastSampleDone = progress.done;
+        lastSampleBytes = progress.bytes;
+    }
 
-    // 全部处理完
-    if (currentIndex >= fileList.size()) {
-        onProcessFinished();
-        return;
+    const int percent = static_cast<int>(100.0 * progress.done / progress.total);
+    if (percent != currentProgress) {
+        currentProgress = percent;
+        progressBar->setValue(currentProgress);
+    }
+
+    QString text = QString("%1/%2  %3 个/秒  %4 MB/s")
+                       .arg(progress.done).arg(progress.total)
+                       .arg(qRound(filesPerSec))
+                       .arg(QString::number(bytesPerSec / (1024.0 * 1024.0), 'f', 1));
+    if (filesPerSec > 0 && progress.done < progress.total) {
+        const qint64 etaSec = qint64((progress.total - progress.done) / filesPerSec);
+        text += QString("  剩余约 %1:%2")
+                    .arg(etaSec / 60)
+                    .arg(etaSec % 60, 2, 10, QChar('0'));
     }
+    if (text != statusLabel->text())
+        statusLabel->setText(text);
 
-    // 取当前文件并计算目标目录
-    QFileInfo fi = fileList.at(currentIndex++);
-    QString subDir = floderNameMap.value(fi.fileName(),"未分类");
-
-    // 创建子目录并移动文件
-    QDir dir(rootDir);
-    if (!dir.exists(subDir))
-        dir.mkdir(subDir);
-    QString dstPath = dir.filePath(subDir + "/" + fi.fileName());
-    if (QFile::exists(dstPath))
-        QFile::remove(dstPath);            // 简单覆盖
-    if (QFile::rename(fi.filePath(), dstPath))
-        history << qMakePair(dstPath, fi.filePath());   // 记录
-
-    // 更新进度条
-    currentProgress = static_cast<int>(100.0 * currentIndex / fileList.size());
-    progressBar->setValue(currentProgress);
-    statusLabel->setText(QString("处理进度: %1%").arg(currentProgress));
+    const QString current = currentFileLabel->fontMetrics().elidedText(
+        QFileInfo(progress.currentFile).fileName(), Qt::ElideMiddle, currentFileLabel->width());
+    if (current != currentFileLabel->text())
+        currentFileLabel->setText(current);
 }
 
 
 
-void ExecuteWindow::onProcessFinished()
+void ExecuteWindow::onProcessFinished(bool aborted)
 {
-    progressTimer->stop();
+    const bool journalFailed = executor && executor->journalFailed();
+    stopWorker();
+    if (!isProcessing) return;
+
+    if (aborted && journalFailed) {
+        // 日志写不进去就不能保证崩溃后可恢复，执行器已在写入意图前停下；
+        // 已完成的部分仍在 history 中，留在窗口里让用户决定保留还是撤销
+        isProcessing = false;
+        isFinished   = true;
+        pauseButton->setEnabled(false);
+        currentFileLabel->clear();
+        finishButton->setEnabled(true);
+        finishButton->setText("完成");
+        statusLabel->setText("执行日志不可用，已停止");
+        QMessageBox::warning(this, "执行日志不可用",
+                             "执行日志无法写入或落盘（磁盘已满或不可写？），为保证异常退出后仍可恢复，已停止执行。\n"
+                             "已处理的文件保持现状，可点击“撤销”恢复。");
+        return;
+    }
+
+    if (aborted) {
+        // 用户中止前会先断开连接，能收到说明是执行器自身失败（如计划文件无法写入）
+        isProcessing = false;
+        QMessageBox::warning(this, "处理失败", executeOptions.dryRun
+                                                 ? "无法写入执行计划文件：" + executeOptions.planPath
+                                                 : QString("文件分类处理未能完成。"));
+        reject();
+        return;
+    }
+
     isProcessing = false;
     isFinished   = true;
+    pauseButton->setEnabled(false);
+    if (journal) journal->markFinished();
 
+    currentFileLabel->clear();
     progressBar->setValue(100);
-    statusLabel->setText("文件分类处理完成！");
     finishButton->setEnabled(true);
     finishButton->setText("完成");
 
+    if (executeOptions.dryRun) {
+        // 演练没有改动任何文件，无可撤销
+        undoButton->setEnabled(false);
+        statusLabel->setText("执行计划已生成！");
+        QMessageBox::information(this, "计划已生成",
+                                 "执行计划已写入：\n" + executeOptions.planPath);
+        return;
+    }
+
+    statusLabel->setText("文件分类处理完成！");
+    if (!executeOptions.planFailed.isEmpty()) {
+        QMessageBox::information(this, "处理完成",
+                                 QString("文件分类处理已完成，续传前有 %1 个文件未能补完，保持在原处。")
+                                     .arg(executeOptions.planFailed.size()));
+        return;
+    }
     QMessageBox::information(this, "处理完成", "文件分类处理已成功完成！");
 }
 
@@ -227,16 +399,62 @@ void ExecuteWindow::onProcessFinished()
 void ExecuteWindow::on_finishButton_clicked()
 {
     if (isFinished) {
+        discardJournal();
         accept(); // 关闭对话框并返回Accepted
     }
 }
 
+void ExecuteWindow::on_pauseButton_clicked()
+{
+    if (!isProcessing || !executor) return;
+
+    isPaused = !isPaused;
+    executor->setPaused(isPaused);
+    pauseButton->setText(isPaused ? "继续" : "暂停");
+    if (isPaused) {
+        // 暂停期间不采样，恢复后速率从恢复时刻重新计算
+        progressTimer->stop();
+        statusLabel->setText("已暂停（当前批次完成后停下）");
+    } else {
+        const ExecuteProgress progress = executor->progress();
+        lastSampleMs = runTimer.elapsed();
+        lastSampleDone = progress.done;
+        lastSampleBytes = progress.bytes;
+        progressTimer->start();
+    }
+}
+
+void ExecuteWindow::reject()
+{
+    if (isProcessing) {
+        interruptKeepingJournal();
+        QMessageBox::information(this, "已停止",
+                                 "已在当前批次处停止，已处理的文件保持现状。\n"
+                                 "下次启动时可选择从断点继续、撤销或补完。");
+    }
+    QDialog::reject();
+}
+
+void ExecuteWindow::interruptKeepingJournal()
+{
+    isProcessing = false;
+    disconnect(executor, nullptr, this, nullptr);
+    executor->requestAbort();
+    stopWorker();
+    history.clear();
+    // 只关闭日志文件，不删除；计划文件也随之保留
+    delete journal;
+    journal = nullptr;
+}
+
 void ExecuteWindow::on_undoButton_clicked()
 {
     // 处理中 → 中止并撤销已完成部分
     if (isProcessing) {
-        progressTimer->stop();
         isProcessing = false;
+        disconnect(executor, nullptr, this, nullptr);
+        executor->requestAbort();
+        stopWorker();
         undoFileClassification();
         QMessageBox::information(this,"已撤销","已中止并撤销已完成的移动操作。");
         reject();
@@ -257,26 +475,71 @@ void ExecuteWindow::on_undoButton_clicked()
 
 void ExecuteWindow::undoFileClassification()
 {
-    // 反向移动文件，避免覆盖
-    for (int i = history.size() - 1; i >= 0; --i) {
-        const QString &src = history[i].first;   // 现位置（分类后）
-        const QString &dst = history[i].second;  // 原位置
-
-        // 先把文件搬回
-        QDir().mkpath(QFileInfo(dst).absolutePath());
-        QFile::rename(src, dst);
-
-        // ---------- 删除可能空掉的目录 ----------
-        QDir dir(QFileInfo(src).absolutePath()); // 分类文件所在目录
-        while (dir.path() != rootDir) {          // 不越过根目录
-            if (!dir.entryList(QDir::NoDotAndDotDot | QDir::AllEntries).isEmpty())
-                break;                           // 目录还有别的东西，退出
-            QDir parent = dir;  parent.cdUp();   // 记录父目录后删除自己
-            parent.rmdir(dir.dirName());         // 仅当空时才会成功
-            dir = parent;                        // 继续向上
+    // 1. 按分类后所在目录分组，同一目录的记录交给同一个线程
+    QHash<QString, QVector<int>> groups;
+    QSet<QString> originalDirs;
+    for (int i = 0; i < history.size(); ++i) {
+        groups[QFileInfo(history[i].currentPath).absolutePath()] << i;
+        if (history[i].kind == ExecuteRecord::Moved || history[i].kind == ExecuteRecord::Deduped)
+            originalDirs.insert(QFileInfo(history[i].originalPath).absolutePath());
+    }
+    for (const QString &dir : std::as_const(originalDirs))
+        QDir().mkpath(dir);                      // 原目录每个只确认一次
+
+    // 2. 各组并行、组内倒序撤销，避免覆盖
+    QThreadPool pool;
+    pool.setMaxThreadCount(executeOptions.workerCount > 0 ? executeOptions.workerCount
+                                                          : QThread::idealThreadCount());
+    for (auto it = groups.cbegin(); it != groups.cend(); ++it) {
+        const QVector<int> indices = it.value();
+        pool.start([this, indices]() {
+            MoveEngine engine(rootDir);
+            for (int k = indices.size() - 1; k >= 0; --k) {
+                const ExecuteRecord &record = history.at(indices.at(k));
+                bool undone;
+                if (record.kind == ExecuteRecord::Copied || record.kind == ExecuteRecord::Linked)
+                    undone = engine.remove(record.currentPath);   // 复制、链接模式：原文件未动，删除副本或链接即可
+                else if (record.kind == ExecuteRecord::Deduped)
+                    undone = engine.restoreFromTrash(record.currentPath, record.originalPath);   // 去重的源文件从回收站放回
+                else
+                    undone = engine.restore(record.currentPath, record.originalPath);
+                // 被替换的旧文件从回收站放回原处
+                if (undone && !record.displacedPath.isEmpty())
+                    engine.restoreFromTrash(record.displacedPath, record.currentPath);
+            }
+        });
+    }
+    pool.waitForDone();
+
+    // 3. 每个涉及的目录（及其到根目录之间的上级）只尝试 rmdir 一次，
+    //    由深到浅进行，非空时 rmdir 失败即跳过，无需列目录判断
+    QString rootPrefix = QDir::cleanPath(rootDir);
+    if (!rootPrefix.endsWith('/')) rootPrefix += '/';
+    QSet<QString> touchedDirs;
+    for (auto it = groups.cbegin(); it != groups.cend(); ++it) {
+        QString dir = QDir::cleanPath(it.key());
+        while (dir.startsWith(rootPrefix) && !touchedDirs.contains(dir)) {
+            touchedDirs.insert(dir);
+            dir = QFileInfo(dir).path();
         }
     }
+    QStringList pruneOrder = touchedDirs.values();
+    std::sort(pruneOrder.begin(), pruneOrder.end(), [](const QString &a, const QString &b) {
+        return a.count('/') > b.count('/');
+    });
+    for (const QString &dir : std::as_const(pruneOrder))
+        QDir().rmdir(dir);
+
     history.clear();
+    discardJournal();
+}
+
+void ExecuteWindow::discardJournal()
+{
+    if (!journal) return;
+    journal->discard();
+    delete journal;
+    journal = nullptr;
 }
 
 
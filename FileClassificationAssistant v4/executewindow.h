@@ -8,9 +8,14 @@
 #include <QProgressBar>
 #include <QPushButton>
 #include <QLabel>
+#include <QThread>
+#include <QElapsedTimer>
 #include <QTimer>
 #include <QFileInfo>
 #include <QPair>
+#include "moveexecutor.h"
+
+class ExecuteJournal;
 
 class ExecuteWindow : public QDialog
 {
@@ -21,41 +26,63 @@ public:
     ExecuteWindow(const QString& rootPath,
                   const QList<QFileInfo>& files,
                   const QMap<QString, QString> & floderMap,
-                  QWidget *parent = nullptr);
+                  QWidget *parent = nullptr,
+                  const ExecuteOptions &options = ExecuteOptions());
     ~ExecuteWindow();
 
+    void reject() override;           // 执行中关闭：停下并保留日志，下次启动可续传
+
 private slots:
-    void updateProgress();            // 每次处理 1 个文件
-    void onProcessFinished();         // 全部完成
+    void sampleProgress();            // 定时读取执行器计数并刷新界面
+    void onProcessFinished(bool aborted);     // 全部完成
     void on_finishButton_clicked();   // 完成按钮
     void on_undoButton_clicked();     // 撤销 / 中止
+    void on_pauseButton_clicked();    // 暂停 / 继续
 
 private:
     void setupUI();
-    void startFileClassification();   // 启动定时器
+    void startFileClassification();   // 启动工作线程
+    void stopWorker();                // 等待工作线程退出并取回移动记录
     void undoFileClassification();    // 撤销已移动文件
     void resetProgress();
+    void discardJournal();            // 结果已确认或已撤销，删除执行日志
+    void interruptKeepingJournal();   // 停止执行但保留日志与计划，供下次启动续传
+
+    static const int ProgressSampleMs = 66;            // 约 15 Hz
+    static constexpr double RateTimeConstantSec = 3.0; // 速率平滑的时间常数
 
     // ---------- UI ----------
     QVBoxLayout *mainLayout;
     QHBoxLayout *buttonLayout;
     QLabel      *titleLabel;
     QLabel      *statusLabel;
+    QLabel      *currentFileLabel;    // 当前处理的文件
     QProgressBar*progressBar;
     QPushButton *finishButton;
     QPushButton *undoButton;
+    QPushButton *pauseButton;
 
     // ---------- 运行数据 ----------
-    QTimer                       *progressTimer;
+    QThread                      *workerThread;
+    MoveExecutor                 *executor;
+    ExecuteJournal               *journal;     // 预写日志，程序异常退出后用于恢复
+    QTimer                       *progressTimer; // 固定频率采样进度，界面开销与处理速度无关
+    QElapsedTimer                 runTimer;    // 本次执行计时，用于计算速率
+    qint64                        lastSampleMs;
+    int                           lastSampleDone;
+    qint64                        lastSampleBytes;
+    double                        filesPerSec; // 指数滑动平均后的速率
+    double                        bytesPerSec;
     int                           currentProgress;
     bool                          isProcessing;
     bool                          isFinished;
+    bool                          isPaused;
 
     QString                       rootDir;     // 根目录
     QList<QFileInfo>              fileList;    // 要处理的文件
     QMap<QString,QString>         floderNameMap;
-    int                           currentIndex;// 当前处理到的文件下标
-    QList<QPair<QString,QString>> history;     // <现路径, 原路径> 用于撤销
+    ExecuteOptions                executeOptions;
+    QList<ExecuteRecord>          history;     // 执行记录，用于撤销
 };
 
 #endif // EXECUTEWINDOW_H
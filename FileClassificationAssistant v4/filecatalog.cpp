@@ -0,0 +1,140 @@
+// 文件目录表：一次扫描得到的文件记录及派生统计
+#include "filecatalog.h"
+#include "iothrottle.h"
+#include "parallelsort.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QtAlgorithms>
+#include <QCollator>
+#include <vector>
+#include <algorithm>
+
+FileCatalog::FileCatalog(const QString &rootPath)
+    : m_rootPath(rootPath)
+{
+}
+
+bool FileCatalog::scan()
+{
+    m_names.clear();
+    m_suffixes.clear();
+    m_sizes.clear();
+    m_mtimes.clear();
+    m_nameRanks.clear();
+    m_totalSize = 0;
+    m_suffixHistogram.clear();
+    m_sortedMTimes.clear();
+    m_sizeBins.fill(0, SizeBinCount);
+
+    QDir dir(m_rootPath);
+    if (!dir.exists()) {
+        return false;
+    }
+
+    QFileInfoList fileList = dir.entryInfoList(QDir::Files | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System | QDir::Readable);
+    // 扫描在界面线程中进行，不能等待；每个条目的 stat 记入共用额度，后台的哈希、移动相应让出
+    IoThrottle::instance().charge(fileList.size(), 0);
+    m_names.reserve(fileList.size());
+    m_suffixes.reserve(fileList.size());
+    m_sizes.reserve(fileList.size());
+    m_mtimes.reserve(fileList.size());
+
+    for (const QFileInfo &fileInfo : fileList) {
+        if (!fileInfo.isFile()) {
+            continue;
+        }
+        qint64 fileSize = fileInfo.size();
+        QString suffix = fileInfo.suffix();
+
+        m_names << fileInfo.fileName();
+        m_suffixes << suffix;
+        m_sizes << fileSize;
+        m_mtimes << fileInfo.lastModified().toMSecsSinceEpoch();
+
+        m_totalSize += fileSize;
+        m_suffixHistogram[suffix]++;
+        m_sizeBins[sizeBin(fileSize)]++;
+    }
+
+    m_sortedMTimes = m_mtimes;
+    std::sort(m_sortedMTimes.begin(), m_sortedMTimes.end());
+    computeNameRanks();
+    return true;
+}
+
+void FileCatalog::computeNameRanks()
+{
+    // 区域比较逐字符查表，直接拿来排序太慢；先为每个文件名生成排序键（分块并行，
+    // 每个线程用自己的 QCollator），键之间的比较只是逐字节比较
+    const int count = size();
+    const int chunks = qBound(1, count / 8192, qMax(1, QThread::idealThreadCount()));
+    std::vector<std::vector<QCollatorSortKey>> chunkKeys(chunks);
+    {
+        QThreadPool pool;
+        for (int c = 0; c < chunks; ++c) {
+            pool.start([this, c, chunks, count, &chunkKeys]() {
+                QCollator collator;
+                collator.setNumericMode(true);
+                collator.setCaseSensitivity(Qt::CaseInsensitive);
+                const int begin = int(qint64(count) * c / chunks);
+                const int end = int(qint64(count) * (c + 1) / chunks);
+                std::vector<QCollatorSortKey> &keys = chunkKeys[c];
+                keys.reserve(end - begin);
+                for (int id = begin; id < end; ++id)
+                    keys.push_back(collator.sortKey(m_names.at(id)));
+            });
+        }
+        pool.waitForDone();
+    }
+    std::vector<QCollatorSortKey> keys;
+    keys.reserve(count);
+    for (std::vector<QCollatorSortKey> &chunk : chunkKeys) {
+        std::move(chunk.begin(), chunk.end(), std::back_inserter(keys));
+        std::vector<QCollatorSortKey>().swap(chunk);
+    }
+
+    // 按键排序文件 ID，键相同时按 ID 保证结果确定
+    std::vector<int> ids(count);
+    for (int id = 0; id < count; ++id)
+        ids[id] = id;
+    parallelSort(ids.begin(), ids.end(), [&keys](int a, int b) {
+        const int c = keys[a].compare(keys[b]);
+        return c != 0 ? c < 0 : a < b;
+    });
+
+    m_nameRanks.resize(count);
+    for (int rank = 0; rank < count; ++rank)
+        m_nameRanks[ids[rank]] = rank;
+}
+
+QMap<QString, int> FileCatalog::groupedSuffixHistogram(bool mergeSmall) const
+{
+    if (!mergeSmall) {
+        return m_suffixHistogram;
+    }
+
+    // 将占比小于 5% 的文件类型合并为"其他"
+    QMap<QString, int> grouped;
+    int thresholdCount = size() * 0.05;
+    for (auto it = m_suffixHistogram.constBegin(); it != m_suffixHistogram.constEnd(); ++it) {
+        if (it.value() >= thresholdCount) {
+            grouped[it.key()] = it.value();
+        } else {
+            grouped["其他"] += it.value();
+        }
+    }
+    return grouped;
+}
+
+int FileCatalog::sizeBin(qint64 size)
+{
+    // 最高位所在位置即对数下取整加一：前导零计数是一条指令，0 字节自然落在第 0 格
+    return size <= 0 ? 0 : 64 - int(qCountLeadingZeroBits(quint64(size)));
+}
+
+int FileCatalog::countModifiedSince(qint64 sinceMSecs) const
+{
+    auto it = std::lower_bound(m_sortedMTimes.cbegin(), m_sortedMTimes.cend(), sinceMSecs);
+    return static_cast<int>(m_sortedMTimes.cend() - it);
+}
@@ -0,0 +1,61 @@
+// 文件目录表：一次扫描得到的文件记录及派生统计
+#ifndef FILECATALOG_H
+#define FILECATALOG_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QMap>
+
+class FileCatalog
+{
+public:
+    explicit FileCatalog(const QString &rootPath);
+
+    // 枚举根目录并重建记录及统计；目录不存在时返回 false
+    bool scan();
+
+    QString rootPath() const { return m_rootPath; }
+    int size() const { return m_names.size(); }
+
+    // 按文件 ID（扫描顺序下标）访问记录
+    const QString &fileName(int id) const { return m_names.at(id); }
+    const QString &suffix(int id) const { return m_suffixes.at(id); }
+    qint64 fileSize(int id) const { return m_sizes.at(id); }
+    qint64 modifiedMSecs(int id) const { return m_mtimes.at(id); }
+
+    // 文件名按当前区域排序规则（数字按数值、不区分大小写）的名次，0 起；
+    // 扫描时用排序键一次算好，之后按名称排序只需比较整数
+    int nameRank(int id) const { return m_nameRanks.at(id); }
+
+    // ---------- 派生统计（扫描时一次算好，之后只做投影） ----------
+    qint64 totalSize() const { return m_totalSize; }
+    const QMap<QString, int> &suffixHistogram() const { return m_suffixHistogram; }
+
+    // 后缀直方图的投影：mergeSmall 为 true 时占比小于 5% 的类型合并为"其他"
+    QMap<QString, int> groupedSuffixHistogram(bool mergeSmall) const;
+
+    // 文件大小的对数直方图：第 0 格为 0 字节，第 k 格（1 ~ 63）为 [2^(k-1), 2^k) 字节
+    static const int SizeBinCount = 64;
+    const QVector<int> &sizeHistogram() const { return m_sizeBins; }
+    static int sizeBin(qint64 size);
+
+    // 修改时间不早于 sinceMSecs 的文件数（已排序索引上二分查找）
+    int countModifiedSince(qint64 sinceMSecs) const;
+
+private:
+    void computeNameRanks();
+    QString         m_rootPath;
+    QStringList     m_names;            // 文件名
+    QStringList     m_suffixes;         // 原始后缀
+    QVector<qint64> m_sizes;            // 文件大小（字节）
+    QVector<qint64> m_mtimes;           // 修改时间（毫秒）
+    QVector<int>    m_nameRanks;        // 文件名排序名次
+
+    qint64             m_totalSize = 0;
+    QMap<QString, int> m_suffixHistogram;   // 后缀 -> 文件数
+    QVector<qint64>    m_sortedMTimes;      // 升序排列的修改时间
+    QVector<int>       m_sizeBins;          // 对数大小直方图，SizeBinCount 格
+};
+
+#endif // FILECATALOG_H
@@ -0,0 +1,298 @@
+// 预览窗口中的文件列表：数据模型只存文件 ID 和选中状态，绘制代理只画可见行
+#include "filelistmodel.h"
+#include "filecatalog.h"
+#include "parallelsort.h"
+#include <QPainter>
+#include <QMouseEvent>
+#include <QFontMetrics>
+#include <QtEndian>
+#include <QtAlgorithms>
+#include <cstring>
+#include <vector>
+
+FileListModel::FileListModel(const FileCatalog *catalog, const QVector<int> &fileIds, QObject *parent)
+    : QAbstractListModel(parent),
+    m_catalog(catalog),
+    m_fileIds(fileIds),
+    m_selected(fileIds.size(), true)
+{
+}
+
+int FileListModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return m_mapped ? m_rows.size() : m_fileIds.size();
+}
+
+const QString &FileListModel::fileName(int row) const
+{
+    return m_catalog->fileName(fileId(row));
+}
+
+QVariant FileListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount())
+        return QVariant();
+
+    const int row = sourceRow(index.row());
+    const int id = m_fileIds.at(row);
+    switch (role) {
+    case Qt::DisplayRole:
+        return m_displayFunction ? m_displayFunction(id) : m_catalog->fileName(id);
+    case Qt::ToolTipRole:
+        return m_toolTipFunction ? m_toolTipFunction(id) : m_catalog->fileName(id);
+    case Qt::CheckStateRole:
+        return m_selected.testBit(row) ? Qt::Checked : Qt::Unchecked;
+    default:
+        return QVariant();
+    }
+}
+
+bool FileListModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+    if (!index.isValid() || role != Qt::CheckStateRole)
+        return false;
+    setSelected(index.row(), value.toInt() == Qt::Checked);
+    return true;
+}
+
+Qt::ItemFlags FileListModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return Qt::NoItemFlags;
+    return Qt::ItemIsEnabled | Qt::ItemIsUserCheckable;
+}
+
+void FileListModel::setSelected(int row, bool selected)
+{
+    const int bit = sourceRow(row);
+    if (m_selected.testBit(bit) == selected)
+        return;
+    m_selected.setBit(bit, selected);
+    const QModelIndex changed = index(row);
+    emit dataChanged(changed, changed, {Qt::CheckStateRole});
+}
+
+void FileListModel::setAllSelected(bool selected)
+{
+    m_selected.fill(selected);
+    if (rowCount() > 0)
+        emit dataChanged(index(0), index(rowCount() - 1), {Qt::CheckStateRole});
+}
+
+void FileListModel::invertSelection()
+{
+    // 与全 1 位图异或：QBitArray 按字处理，末尾补齐位在全 1 位图中为 0，不会被置上
+    m_selected ^= QBitArray(m_selected.size(), true);
+    if (rowCount() > 0)
+        emit dataChanged(index(0), index(rowCount() - 1), {Qt::CheckStateRole});
+}
+
+void FileListModel::setFilter(const QBitArray &matchedIds)
+{
+    beginResetModel();
+    m_filter = matchedIds;
+    m_filtered = true;
+    rebuildRows();
+    endResetModel();
+}
+
+void FileListModel::clearFilter()
+{
+    if (!m_filtered)
+        return;
+    beginResetModel();
+    m_filter.clear();
+    m_filtered = false;
+    rebuildRows();
+    endResetModel();
+}
+
+void FileListModel::sort(int column, Qt::SortOrder order)
+{
+    beginResetModel();
+    m_sortColumn = column;
+    m_sortOrder = order;
+    m_order.clear();
+
+    if (column >= SortByName && column <= SortByModifiedTime) {
+        // 每行的键先取出来连续存放，排序时只比较整数，不再回目录表查找
+        struct Entry {
+            qint64 key;
+            int    rank;                  // 文件名名次，同值时的次序
+            int    row;
+        };
+        const int count = m_fileIds.size();
+        std::vector<Entry> entries(count);
+        for (int row = 0; row < count; ++row) {
+            const int id = m_fileIds.at(row);
+            const int rank = m_catalog->nameRank(id);
+            qint64 key = rank;
+            if (column == SortBySize)
+                key = m_catalog->fileSize(id);
+            else if (column == SortByModifiedTime)
+                key = m_catalog->modifiedMSecs(id);
+            entries[row] = {key, rank, row};
+        }
+        if (order == Qt::AscendingOrder) {
+            parallelSort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+                return a.key != b.key ? a.key < b.key : a.rank < b.rank;
+            });
+        } else {
+            parallelSort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+                return a.key != b.key ? a.key > b.key : a.rank > b.rank;
+            });
+        }
+        m_order.reserve(count);
+        for (const Entry &entry : entries)
+            m_order << entry.row;
+    }
+
+    rebuildRows();
+    endResetModel();
+}
+
+void FileListModel::rebuildRows()
+{
+    m_rows.clear();
+    m_mapped = !m_order.isEmpty() || m_filtered;
+    if (!m_mapped)
+        return;
+
+    const int count = m_fileIds.size();
+    m_rows.reserve(m_filtered ? 0 : count);
+    for (int i = 0; i < count; ++i) {
+        const int row = m_order.isEmpty() ? i : m_order.at(i);
+        if (!m_filtered || m_filter.testBit(m_fileIds.at(row)))
+            m_rows << row;
+    }
+}
+
+QVector<int> FileListModel::selectedFileIds() const
+{
+    QVector<int> ids;
+    ids.reserve(selectedCount());
+
+    // QBitArray 的第 i 位在第 i/8 字节的第 i%8 位，按小端读出 64 位字后位号即行号偏移
+    const char *bits = m_selected.bits();
+    const int size = int(m_selected.size());
+    const int byteCount = (size + 7) / 8;
+    for (int byte = 0; byte < byteCount; byte += 8) {
+        quint64 word = 0;
+        std::memcpy(&word, bits + byte, size_t(qMin(8, byteCount - byte)));
+        word = qFromLittleEndian(word);
+        while (word) {
+            ids << m_fileIds.at(byte * 8 + int(qCountTrailingZeroBits(word)));
+            word &= word - 1;         // 清掉最低位的 1
+        }
+    }
+    return ids;
+}
+
+
+// ---------------- 绘制代理 ----------------
+// 尺寸与原先每行的按钮控件一致：左右边距 5，控件间距 8
+
+static const int RowMargin = 5;
+static const int RowSpacing = 8;
+static const int SelectButtonWidth = 67;
+static const int SelectButtonHeight = 22;
+static const int PreviewButtonWidth = 50;
+static const int PreviewButtonHeight = 20;
+
+FileItemDelegate::FileItemDelegate(int rowHeight, QObject *parent)
+    : QStyledItemDelegate(parent),
+    m_rowHeight(rowHeight)
+{
+}
+
+QRect FileItemDelegate::previewButtonRect(const QRect &rowRect) const
+{
+    return QRect(rowRect.right() - RowMargin - PreviewButtonWidth + 1,
+                 rowRect.center().y() - PreviewButtonHeight / 2 + 1,
+                 PreviewButtonWidth, PreviewButtonHeight);
+}
+
+QRect FileItemDelegate::selectButtonRect(const QRect &rowRect) const
+{
+    const QRect preview = previewButtonRect(rowRect);
+    return QRect(preview.left() - RowSpacing - SelectButtonWidth,
+                 rowRect.center().y() - SelectButtonHeight / 2 + 1,
+                 SelectButtonWidth, SelectButtonHeight);
+}
+
+// 画一个圆角按钮；checked 时为蓝底白字
+static void paintButton(QPainter *painter, const QRect &rect, const QString &text, bool checked)
+{
+    painter->setPen(checked ? QColor("#4a90e2") : QColor("#cccccc"));
+    painter->setBrush(checked ? QColor("#4a90e2") : QColor("#f8f9fa"));
+    painter->drawRoundedRect(QRectF(rect).adjusted(0.5, 0.5, -0.5, -0.5), 3, 3);
+    painter->setPen(checked ? Qt::white : QColor("#333333"));
+    painter->drawText(rect, Qt::AlignCenter, text);
+}
+
+void FileItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                             const QModelIndex &index) const
+{
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+
+    const QRect rowRect = option.rect;
+    if (option.state & QStyle::State_MouseOver)
+        painter->fillRect(rowRect, QColor("#f0f8ff"));
+    painter->setPen(QColor("#eeeeee"));
+    painter->drawLine(rowRect.bottomLeft(), rowRect.bottomRight());
+
+    // 文字：多行显示文本逐行省略，超宽部分以 "..." 结尾
+    const QRect selectRect = selectButtonRect(rowRect);
+    const QRect textRect(rowRect.left() + RowMargin, rowRect.top() + 3,
+                         selectRect.left() - RowSpacing - rowRect.left() - RowMargin,
+                         rowRect.height() - 6);
+    QFont font = option.font;
+    font.setPixelSize(m_rowHeight > 30 ? 10 : 11);
+    painter->setFont(font);
+    const QFontMetrics metrics(font);
+    const QStringList lines = index.data(Qt::DisplayRole).toString().split('\n');
+    QStringList elided;
+    for (const QString &line : lines)
+        elided << metrics.elidedText(line, Qt::ElideRight, textRect.width());
+    painter->setPen(QColor("#333333"));
+    painter->drawText(textRect, Qt::AlignLeft | Qt::AlignVCenter, elided.join('\n'));
+
+    // 两个按钮
+    font.setPixelSize(10);
+    painter->setFont(font);
+    const bool checked = index.data(Qt::CheckStateRole).toInt() == Qt::Checked;
+    paintButton(painter, selectRect, checked ? "已选中" : "未选中", checked);
+    paintButton(painter, previewButtonRect(rowRect), "预览", false);
+
+    painter->restore();
+}
+
+QSize FileItemDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    Q_UNUSED(index);
+    return QSize(option.rect.width(), m_rowHeight);
+}
+
+bool FileItemDelegate::editorEvent(QEvent *event, QAbstractItemModel *model,
+                                   const QStyleOptionViewItem &option, const QModelIndex &index)
+{
+    if (event->type() != QEvent::MouseButtonRelease)
+        return false;
+    const QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
+    if (mouseEvent->button() != Qt::LeftButton)
+        return false;
+
+    const QPoint pos = mouseEvent->position().toPoint();
+    if (selectButtonRect(option.rect).contains(pos)) {
+        const bool checked = index.data(Qt::CheckStateRole).toInt() == Qt::Checked;
+        model->setData(index, checked ? Qt::Unchecked : Qt::Checked, Qt::CheckStateRole);
+    } else if (previewButtonRect(option.rect).contains(pos)) {
+        emit previewRequested(index);
+    } else {
+        emit itemClicked(index);
+    }
+    return true;
+}
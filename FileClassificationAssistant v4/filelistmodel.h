@@ -0,0 +1,102 @@
+// 预览窗口中的文件列表：数据模型只存文件 ID 和选中状态，绘制代理只画可见行
+#ifndef FILELISTMODEL_H
+#define FILELISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QStyledItemDelegate>
+#include <QVector>
+#include <QBitArray>
+#include <functional>
+
+class FileCatalog;
+
+// 文件列表模型：每行一个文件目录表中的文件 ID，显示文本和提示在绘制时按需生成。
+// 可过滤、排序；公有接口中的 row 均指视图行，选中状态仍按分类内全部文件保存
+class FileListModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    typedef std::function<QString(int fileId)> TextFunction;
+
+    // sort() 的列号
+    enum SortColumn {
+        SortByName,                       // 按目录表中预先算好的文件名名次
+        SortBySize,
+        SortByModifiedTime
+    };
+
+    // 初始时所有文件均为选中；catalog 须在模型存续期间有效
+    FileListModel(const FileCatalog *catalog, const QVector<int> &fileIds, QObject *parent = nullptr);
+
+    // 行的显示文本及提示，参数为文件 ID；未设置时显示文件名
+    void setDisplayFunction(const TextFunction &function) { m_displayFunction = function; }
+    void setToolTipFunction(const TextFunction &function) { m_toolTipFunction = function; }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    int fileCount() const { return m_fileIds.size(); }   // 分类内文件总数，不受过滤影响
+    int fileId(int row) const { return m_fileIds.at(sourceRow(row)); }
+    const QString &fileName(int row) const;
+    bool isSelected(int row) const { return m_selected.testBit(sourceRow(row)); }
+    void setSelected(int row, bool selected);
+    void setAllSelected(bool selected);   // 整个位图（含被过滤掉的行）一次填充，只发一次 dataChanged
+    void invertSelection();               // 整个位图按字取反，只发一次 dataChanged
+
+    int selectedCount() const { return int(m_selected.count(true)); }
+    QVector<int> selectedFileIds() const; // 按行号升序，整字扫描位图，跳过全 0 的字
+
+    // 只显示文件 ID 在 matchedIds 中置位的行（matchedIds 按整个目录表编号）
+    void setFilter(const QBitArray &matchedIds);
+    void clearFilter();
+
+    // 按 SortColumn 排序，同值按文件名；column 为 -1 时恢复扫描顺序。过滤条件保留
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+    int sortColumn() const { return m_sortColumn; }
+    Qt::SortOrder sortOrder() const { return m_sortOrder; }
+
+private:
+    int sourceRow(int row) const { return m_mapped ? m_rows.at(row) : row; }
+    void rebuildRows();                   // 按排序结果和过滤条件重建视图行
+
+    const FileCatalog *m_catalog;
+    QVector<int>   m_fileIds;             // 每行 4 字节，文件记录只在目录表中存一份
+    QBitArray      m_selected;            // 选中位图，第 i 位对应 m_fileIds[i]
+    QVector<int>   m_order;               // 排序后的 m_fileIds 下标，未排序时为空
+    QBitArray      m_filter;              // 过滤条件，按文件 ID
+    bool           m_filtered = false;
+    QVector<int>   m_rows;                // 排序或过滤时：视图行 -> m_fileIds 下标
+    bool           m_mapped = false;
+    int            m_sortColumn = -1;
+    Qt::SortOrder  m_sortOrder = Qt::AscendingOrder;
+    TextFunction   m_displayFunction;
+    TextFunction   m_toolTipFunction;
+};
+
+// 文件行绘制代理：文字加"已选中/未选中"和"预览"两个画出来的按钮，不为每行创建控件
+class FileItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+public:
+    explicit FileItemDelegate(int rowHeight, QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    bool editorEvent(QEvent *event, QAbstractItemModel *model,
+                     const QStyleOptionViewItem &option, const QModelIndex &index) override;
+
+signals:
+    void previewRequested(const QModelIndex &index);   // 点击"预览"
+    void itemClicked(const QModelIndex &index);        // 点击按钮以外的区域
+
+private:
+    QRect selectButtonRect(const QRect &rowRect) const;
+    QRect previewButtonRect(const QRect &rowRect) const;
+
+    int m_rowHeight;
+};
+
+#endif // FILELISTMODEL_H
@@ -0,0 +1,134 @@
+// 文件名三字母组（trigram）索引：预览窗口的文件名子串搜索，索引在后台线程中建立一次
+#include "filenameindex.h"
+#include "filecatalog.h"
+#include <algorithm>
+
+FileNameIndex::FileNameIndex(const QSharedPointer<const FileCatalog> &catalog)
+    : m_catalog(catalog),
+    m_ready(0),
+    m_cancelled(0)
+{
+}
+
+quint64 FileNameIndex::trigramKey(QChar a, QChar b, QChar c)
+{
+    // 三个 UTF-16 码元拼成 48 位键；先做大小写折叠，查询时同样折叠
+    return (quint64(a.toCaseFolded().unicode()) << 32)
+         | (quint64(b.toCaseFolded().unicode()) << 16)
+         | quint64(c.toCaseFolded().unicode());
+}
+
+QVector<quint64> FileNameIndex::trigramsOf(const QString &name) const
+{
+    QVector<quint64> keys;
+    if (name.size() < 3)
+        return keys;
+    keys.reserve(name.size() - 2);
+    for (int i = 0; i + 2 < name.size(); ++i)
+        keys << trigramKey(name.at(i), name.at(i + 1), name.at(i + 2));
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+}
+
+void FileNameIndex::build()
+{
+    const FileCatalog &catalog = *m_catalog;
+    const int count = catalog.size();
+
+    // 第一遍：为每个三字母组分配槽并计数
+    QHash<quint64, int> slots;
+    QVector<int> counts;
+    for (int id = 0; id < count; ++id) {
+        if ((id & 0xFFF) == 0 && m_cancelled.loadRelaxed())
+            return;
+        const QVector<quint64> keys = trigramsOf(catalog.fileName(id));
+        for (quint64 key : keys) {
+            auto it = slots.constFind(key);
+            if (it == slots.constEnd()) {
+                slots.insert(key, counts.size());
+                counts << 1;
+            } else {
+                ++counts[it.value()];
+            }
+        }
+    }
+
+    // 前缀和得到每个槽的起点
+    QVector<int> offsets(counts.size() + 1);
+    for (int i = 0; i < counts.size(); ++i)
+        offsets[i + 1] = offsets[i] + counts[i];
+
+    // 第二遍：按 ID 升序填入，各倒排表天然有序
+    QVector<int> postings(offsets.last());
+    QVector<int> cursor = offsets;
+    for (int id = 0; id < count; ++id) {
+        if ((id & 0xFFF) == 0 && m_cancelled.loadRelaxed())
+            return;
+        const QVector<quint64> keys = trigramsOf(catalog.fileName(id));
+        for (quint64 key : keys)
+            postings[cursor[slots.value(key)]++] = id;
+    }
+
+    m_slots.swap(slots);
+    m_offsets.swap(offsets);
+    m_postings.swap(postings);
+    m_ready.storeRelease(1);          // 此后界面线程才会读上面三个成员
+}
+
+QBitArray FileNameIndex::scan(const QString &query) const
+{
+    const FileCatalog &catalog = *m_catalog;
+    QBitArray matches(catalog.size());
+    for (int id = 0; id < catalog.size(); ++id) {
+        if (catalog.fileName(id).contains(query, Qt::CaseInsensitive))
+            matches.setBit(id);
+    }
+    return matches;
+}
+
+QBitArray FileNameIndex::search(const QString &query) const
+{
+    if (query.size() < 3 || !isReady())
+        return scan(query);
+
+    // 取出查询中各三字母组的倒排表，任一不存在即无结果
+    struct Range { const int *begin; const int *end; };
+    QVector<Range> ranges;
+    const QVector<quint64> keys = trigramsOf(query);
+    for (quint64 key : keys) {
+        auto it = m_slots.constFind(key);
+        if (it == m_slots.constEnd())
+            return QBitArray(m_catalog->size());
+        const int *postings = m_postings.constData();
+        ranges.append({postings + m_offsets.at(it.value()), postings + m_offsets.at(it.value() + 1)});
+    }
+
+    // 从最短的表开始求交集，其余表在剩余区间内二分查找
+    std::sort(ranges.begin(), ranges.end(), [](const Range &a, const Range &b) {
+        return (a.end - a.begin) < (b.end - b.begin);
+    });
+    QVector<int> candidates(ranges.first().begin, ranges.first().end);
+    for (int r = 1; r < ranges.size() && !candidates.isEmpty(); ++r) {
+        const int *pos = ranges.at(r).begin;
+        const int *end = ranges.at(r).end;
+        int kept = 0;
+        for (int id : std::as_const(candidates)) {
+            pos = std::lower_bound(pos, end, id);
+            if (pos == end)
+                break;
+            if (*pos == id)
+                candidates[kept++] = id;
+        }
+        candidates.resize(kept);
+    }
+
+    // 三字母组都出现不代表连续出现，逐个核对
+    const FileCatalog &catalog = *m_catalog;
+    QBitArray matches(catalog.size());
+    for (int id : std::as_const(candidates)) {
+        if (catalog.fileName(id).contains(query, Qt::CaseInsensitive))
+            matches.setBit(id);
+    }
+    return matches;
+}
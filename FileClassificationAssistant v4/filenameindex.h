@@ -0,0 +1,44 @@
+// 文件名三字母组（trigram）索引：预览窗口的文件名子串搜索，索引在后台线程中建立一次
+#ifndef FILENAMEINDEX_H
+#define FILENAMEINDEX_H
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QBitArray>
+#include <QAtomicInt>
+#include <QSharedPointer>
+
+class FileCatalog;
+
+class FileNameIndex
+{
+public:
+    explicit FileNameIndex(const QSharedPointer<const FileCatalog> &catalog);
+
+    // 建立索引，耗时与文件名总长成正比；在工作线程中调用，完成前 search() 退化为逐个比较
+    void build();
+    void cancel() { m_cancelled.storeRelaxed(1); }   // 让进行中的 build() 尽快返回
+    bool isReady() const { return m_ready.loadAcquire() != 0; }
+
+    // 文件名包含 query（不区分大小写）的文件，按文件 ID 置位；
+    // 查询不足三个字符或索引未建好时逐个比较，否则取各三字母组倒排表的交集再核对
+    QBitArray search(const QString &query) const;
+
+private:
+    static quint64 trigramKey(QChar a, QChar b, QChar c);
+    QVector<quint64> trigramsOf(const QString &name) const;   // 去重后的三字母组
+    QBitArray scan(const QString &query) const;
+
+    QSharedPointer<const FileCatalog> m_catalog;
+
+    // 倒排表按 CSR 存放：三字母组 -> 槽号，槽 i 的文件 ID 为 m_postings[m_offsets[i] .. m_offsets[i+1])，升序
+    QHash<quint64, int> m_slots;
+    QVector<int>        m_offsets;
+    QVector<int>        m_postings;
+
+    QAtomicInt m_ready;
+    QAtomicInt m_cancelled;
+};
+
+#endif // FILENAMEINDEX_H
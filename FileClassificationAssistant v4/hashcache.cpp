@@ -0,0 +1,100 @@
+// 文件内容哈希缓存：按 (路径, 大小, 修改时间) 记住算过的哈希，文件改动后自动失效
+#include "hashcache.h"
+#include "iothrottle.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include <cstring>
+
+static const int CompareBlockSize = 1 << 20;
+
+HashCache &HashCache::instance()
+{
+    static HashCache cache;
+    return cache;
+}
+
+QByteArray HashCache::cached(const QString &path, qint64 size, qint64 mtimeMSecs) const
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_entries.constFind(path);
+    if (it == m_entries.constEnd() || it->size != size || it->mtime != mtimeMSecs)
+        return QByteArray();
+    return it->hash;
+}
+
+void HashCache::store(const QString &path, qint64 size, qint64 mtimeMSecs, const QByteArray &hash)
+{
+    QMutexLocker locker(&m_mutex);
+    Entry &entry = m_entries[path];
+    entry.size = size;
+    entry.mtime = mtimeMSecs;
+    entry.hash = hash;
+}
+
+bool HashCache::identical(const QString &pathA, const QString &pathB)
+{
+    const QFileInfo infoA(pathA), infoB(pathB);
+    if (!infoA.isFile() || !infoB.isFile() || infoA.size() != infoB.size())
+        return false;
+
+    const qint64 mtimeA = infoA.lastModified().toMSecsSinceEpoch();
+    const qint64 mtimeB = infoB.lastModified().toMSecsSinceEpoch();
+    const QByteArray cachedA = cached(pathA, infoA.size(), mtimeA);
+    const QByteArray cachedB = cached(pathB, infoB.size(), mtimeB);
+    if (!cachedA.isEmpty() && !cachedB.isEmpty())
+        return cachedA == cachedB;
+
+    // 只有一边有缓存：只需读另一边算哈希
+    if (!cachedA.isEmpty() || !cachedB.isEmpty()) {
+        const bool haveA = !cachedA.isEmpty();
+        const QString &path = haveA ? pathB : pathA;
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly))
+            return false;
+        IoThrottle &throttle = IoThrottle::instance();
+        throttle.acquire(1, 0);
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        QByteArray block(CompareBlockSize, Qt::Uninitialized);
+        qint64 n;
+        while ((n = file.read(block.data(), CompareBlockSize)) > 0) {
+            throttle.acquire(0, n);
+            hash.addData(QByteArrayView(block.constData(), n));
+        }
+        if (n < 0)
+            return false;
+        const QByteArray result = hash.result();
+        store(path, infoA.size(), haveA ? mtimeB : mtimeA, result);
+        return result == (haveA ? cachedA : cachedB);
+    }
+
+    // 都没有缓存：两边同时逐块比较，遇到第一处不同即停止
+    QFile fileA(pathA), fileB(pathB);
+    if (!fileA.open(QIODevice::ReadOnly) || !fileB.open(QIODevice::ReadOnly))
+        return false;
+    IoThrottle &throttle = IoThrottle::instance();
+    throttle.acquire(2, 0);
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    QByteArray blockA(CompareBlockSize, Qt::Uninitialized);
+    QByteArray blockB(CompareBlockSize, Qt::Uninitialized);
+    for (;;) {
+        const qint64 n = fileA.read(blockA.data(), CompareBlockSize);
+        const qint64 m = fileB.read(blockB.data(), CompareBlockSize);
+        if (n != m || n < 0)
+            return false;
+        if (n == 0)
+            break;
+        throttle.acquire(0, 2 * n);
+        if (memcmp(blockA.constData(), blockB.constData(), size_t(n)) != 0)
+            return false;
+        hash.addData(QByteArrayView(blockA.constData(), n));
+    }
+
+    // 内容相同，两边哈希相同
+    const QByteArray result = hash.result();
+    store(pathA, infoA.size(), mtimeA, result);
+    store(pathB, infoB.size(), mtimeB, result);
+    return true;
+}
@@ -0,0 +1,36 @@
+// 文件内容哈希缓存：按 (路径, 大小, 修改时间) 记住算过的哈希，文件改动后自动失效
+#ifndef HASHCACHE_H
+#define HASHCACHE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+
+class HashCache
+{
+public:
+    static HashCache &instance();
+
+    // 已缓存且仍有效的哈希，没有时返回空
+    QByteArray cached(const QString &path, qint64 size, qint64 mtimeMSecs) const;
+    void store(const QString &path, qint64 size, qint64 mtimeMSecs, const QByteArray &hash);
+
+    // 两个文件内容是否相同：大小不同直接否定；两边都有缓存时只比哈希；
+    // 否则逐块比较，读完时顺带记下两边的哈希，下次同样的比较无需再读文件
+    bool identical(const QString &pathA, const QString &pathB);
+
+private:
+    HashCache() {}
+
+    struct Entry {
+        qint64     size = -1;
+        qint64     mtime = 0;
+        QByteArray hash;
+    };
+
+    mutable QMutex        m_mutex;
+    QHash<QString, Entry> m_entries;
+};
+
+#endif // HASHCACHE_H
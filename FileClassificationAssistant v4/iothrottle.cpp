@@ -0,0 +1,125 @@
+// 后台 I/O 限速：扫描、哈希、移动共用一个令牌桶，并可降低工作线程的 I/O 及 CPU 优先级
+#include "iothrottle.h"
+#include <QSettings>
+#include <QThread>
+
+#ifdef Q_OS_LINUX
+#include <sys/syscall.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+static const int SleepSliceMs = 100;          // 等待期间检查中止的间隔
+
+IoThrottle &IoThrottle::instance()
+{
+    static IoThrottle throttle;
+    return throttle;
+}
+
+IoThrottle::IoThrottle()
+    : m_limited(0)
+{
+    m_clock.start();
+
+    QSettings settings(QSettings::IniFormat, QSettings::UserScope,
+                       "FileClassificationAssistant", "io");
+    Limits limits;
+    limits.opsPerSec = settings.value("opsPerSec", 0).toInt();
+    limits.bytesPerSec = settings.value("bytesPerSec", 0).toLongLong();
+    limits.ioClass = settings.value("ioClass", "best-effort").toString() == "idle" ? Idle : BestEffort;
+    limits.niceLevel = qBound(0, settings.value("nice", 0).toInt(), 19);
+    setLimits(limits);
+}
+
+IoThrottle::Limits IoThrottle::limits() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_limits;
+}
+
+void IoThrottle::setLimits(const Limits &limits)
+{
+    QMutexLocker locker(&m_mutex);
+    m_limits = limits;
+    // 桶容量为一秒的额度，改设置后从满桶开始
+    m_opTokens = qMax(0, limits.opsPerSec);
+    m_byteTokens = double(qMax<qint64>(0, limits.bytesPerSec));
+    m_lastRefillNs = m_clock.nsecsElapsed();
+    m_limited.storeRelaxed(limits.opsPerSec > 0 || limits.bytesPerSec > 0);
+}
+
+void IoThrottle::save() const
+{
+    const Limits limits = this->limits();
+    QSettings settings(QSettings::IniFormat, QSettings::UserScope,
+                       "FileClassificationAssistant", "io");
+    settings.setValue("opsPerSec", limits.opsPerSec);
+    settings.setValue("bytesPerSec", limits.bytesPerSec);
+    settings.setValue("ioClass", limits.ioClass == Idle ? "idle" : "best-effort");
+    settings.setValue("nice", limits.niceLevel);
+}
+
+double IoThrottle::reserve(int ops, qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    const qint64 now = m_clock.nsecsElapsed();
+    const double elapsed = (now - m_lastRefillNs) / 1e9;
+    m_lastRefillNs = now;
+
+    double wait = 0;
+    if (m_limits.opsPerSec > 0) {
+        const double rate = m_limits.opsPerSec;
+        m_opTokens = qMin(rate, m_opTokens + rate * elapsed) - ops;
+        if (m_opTokens < 0)
+            wait = -m_opTokens / rate;
+    }
+    if (m_limits.bytesPerSec > 0) {
+        const double rate = double(m_limits.bytesPerSec);
+        m_byteTokens = qMin(rate, m_byteTokens + rate * elapsed) - double(bytes);
+        if (m_byteTokens < 0)
+            wait = qMax(wait, -m_byteTokens / rate);
+    }
+    return wait;
+}
+
+void IoThrottle::acquire(int ops, qint64 bytes, const QAtomicInt *abort)
+{
+    if (!m_limited.loadRelaxed())
+        return;
+
+    // 额度在锁内一次扣除，等待在锁外进行：先到者先得，后到者排在透支之后
+    qint64 remainingMs = qint64(reserve(ops, bytes) * 1000);
+    while (remainingMs > 0 && !(abort && abort->loadRelaxed())) {
+        const qint64 slice = qMin<qint64>(remainingMs, SleepSliceMs);
+        QThread::msleep(static_cast<unsigned long>(slice));
+        remainingMs -= slice;
+    }
+}
+
+void IoThrottle::charge(int ops, qint64 bytes)
+{
+    if (m_limited.loadRelaxed())
+        reserve(ops, bytes);
+}
+
+void IoThrottle::applyToCurrentThread() const
+{
+#ifdef Q_OS_LINUX
+    const Limits limits = this->limits();
+
+    // ioprio_set 没有 glibc 封装；who 为 0 时作用于调用线程
+    const int IoprioWhoProcess = 1;
+    const int IoprioClassShift = 13;
+    const int IoprioClassBestEffort = 2;
+    const int IoprioClassIdle = 3;
+    const int value = limits.ioClass == Idle
+                          ? (IoprioClassIdle << IoprioClassShift)
+                          : (IoprioClassBestEffort << IoprioClassShift) | 4;   // 4 为默认级别
+    syscall(SYS_ioprio_set, IoprioWhoProcess, 0, value);
+
+    // Linux 的 nice 值按线程生效；普通用户只能调高，失败时保持原值
+    if (limits.niceLevel > 0)
+        setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), limits.niceLevel);
+#endif
+}
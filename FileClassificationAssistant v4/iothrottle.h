@@ -0,0 +1,54 @@
+// 后台 I/O 限速：扫描、哈希、移动共用一个令牌桶，并可降低工作线程的 I/O 及 CPU 优先级
+#ifndef IOTHROTTLE_H
+#define IOTHROTTLE_H
+
+#include <QtGlobal>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+
+class IoThrottle
+{
+public:
+    enum IoClass {
+        BestEffort,                   // 普通（尽力而为，与其他进程平分磁盘）
+        Idle                          // 仅在磁盘空闲时读写
+    };
+
+    struct Limits {
+        int     opsPerSec = 0;        // 每秒文件操作数，0 表示不限
+        qint64  bytesPerSec = 0;      // 每秒读写字节数，0 表示不限
+        IoClass ioClass = BestEffort;
+        int     niceLevel = 0;        // 工作线程的 nice 值（0 ~ 19）
+    };
+
+    static IoThrottle &instance();
+
+    Limits limits() const;
+    void setLimits(const Limits &limits);
+    void save() const;                // 保存到用户设置，下次启动自动载入
+
+    // 申请 ops 次操作、bytes 字节的额度，超出速率时阻塞等待；
+    // abort 非空且被置位时提前返回。只应在工作线程中调用
+    void acquire(int ops, qint64 bytes, const QAtomicInt *abort = nullptr);
+
+    // 只记账不等待：界面线程中的读写占用额度，让后台线程相应让出
+    void charge(int ops, qint64 bytes);
+
+    // 按设置调整调用线程的 I/O 调度类和 nice 值（Linux），工作线程开始干活前调用
+    void applyToCurrentThread() const;
+
+private:
+    IoThrottle();
+    double reserve(int ops, qint64 bytes);   // 扣除额度，返回需要等待的秒数
+
+    mutable QMutex m_mutex;
+    Limits         m_limits;
+    QAtomicInt     m_limited;         // 是否设置了速率，未设置时 acquire 只有一次原子读
+    QElapsedTimer  m_clock;
+    qint64         m_lastRefillNs = 0;
+    double         m_opTokens = 0;    // 可为负：大块申请先透支，申请者等到补足再继续
+    double         m_byteTokens = 0;
+};
+
+#endif // IOTHROTTLE_H
@@ -1,6 +1,10 @@
 //第一个出现的窗口：选择目录窗口
 #include "mainwindow.h"
 #include "classificationwindow.h"
+#include "executejournal.h"
+#include "executewindow.h"
+#include "moveplan.h"
+#include "iothrottle.h"
 #include "ui_mainwindow.h"
 #include <QDialog>
 #include <QVBoxLayout>
@@ -9,6 +13,12 @@
 #include <QPushButton>
 #include <QFileDialog>
 #include <QDebug>
+#include <QMessageBox>
+#include <QTimer>
+#include <QFormLayout>
+#include <QSpinBox>
+#include <QComboBox>
+#include <QDialogButtonBox>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -16,6 +26,13 @@ MainWindow::MainWindow(QWidget *parent)
 {
     ui->setupUi(this);
     resize(1000, 800);
+
+    // 演练生成的计划文件在审阅后从这里执行
+    ui->menu->addAction("按计划文件执行...", this, &MainWindow::executePlanFile);
+    ui->menu->addAction("后台 I/O 限制...", this, &MainWindow::editIoLimits);
+
+    // 窗口显示后再检查，提示框有父窗口可依附
+    QTimer::singleShot(0, this, &MainWindow::recoverPendingJournals);
 }
 
 MainWindow::~MainWindow()
@@ -23,6 +40,189 @@ MainWindow::~MainWindow()
     delete ui;
 }
 
+void MainWindow::recoverPendingJournals()
+{
+    const QStringList journals = ExecuteJournal::pendingJournals();
+    for (const QString &path : journals) {
+        QMessageBox box(QMessageBox::Warning, "发现未完成的分类操作",
+                        "上次运行时文件分类未正常结束：\n\n" + ExecuteJournal::describe(path)
+                            + "\n\n请选择恢复方式：",
+                        QMessageBox::NoButton, this);
+        // 有计划文件和检查点的中断执行可以从断点续传
+        ExecuteJournal::ResumePoint resume;
+        const bool canResume = ExecuteJournal::resumePoint(path, &resume);
+        QPushButton *resumeButton = canResume ? box.addButton("从断点继续", QMessageBox::AcceptRole)
+                                              : nullptr;
+        QPushButton *rollbackButton = box.addButton("撤销（恢复原位置）", QMessageBox::AcceptRole);
+        QPushButton *completeButton = box.addButton(canResume ? "只补完已记录的操作" : "继续完成",
+                                                    QMessageBox::AcceptRole);
+        box.addButton("稍后处理", QMessageBox::RejectRole);
+        box.exec();
+
+        if (resumeButton && box.clickedButton() == resumeButton) {
+            resumeInterruptedRun(path, resume);
+            continue;
+        }
+
+        ExecuteJournal::ReplayAction action;
+        if (box.clickedButton() == rollbackButton)      action = ExecuteJournal::Rollback;
+        else if (box.clickedButton() == completeButton) action = ExecuteJournal::Complete;
+        else continue;                                    // 保留日志，下次启动再问
+
+        int failed = 0;
+        int handled = ExecuteJournal::replay(path, action, &failed);
+        if (failed == 0) {
+            QMessageBox::information(this, "恢复完成", QString("已处理 %1 个文件。").arg(handled));
+        } else {
+            QMessageBox::warning(this, "恢复未全部成功",
+                                 QString("已处理 %1 个文件，%2 个文件未能恢复，日志已保留：\n%3")
+                                     .arg(handled).arg(failed).arg(path));
+        }
+    }
+}
+
+void MainWindow::resumeInterruptedRun(const QString &journalPath,
+                                      const ExecuteJournal::ResumePoint &resume)
+{
+    // 先补完检查点之后已记录意图的操作，再从检查点继续执行计划的其余部分
+    int failed = 0;
+    QStringList failedSources;
+    ExecuteJournal::replay(journalPath, ExecuteJournal::Complete, &failed, true, &failedSources);
+    if (failed > 0) {
+        // 个别文件补不完（如无法读取）不应拖累整个执行：这些文件保持原状，都在断点之前或已在
+        // handledSources 中，续传时不会再处理；旧日志的其余内容与全部成功时一样不再需要
+        QString text = QString("%1 个已记录的操作未能补完，这些文件保持原状并跳过，其余任务从断点继续：")
+                           .arg(failed);
+        for (int i = 0; i < qMin(int(failedSources.size()), 10); ++i)
+            text += "\n" + failedSources.at(i);
+        if (failedSources.size() > 10)
+            text += "\n...";
+        QMessageBox::warning(this, "部分操作未能补完", text);
+        ExecuteJournal::remove(journalPath, true);
+    }
+
+    MovePlanReader reader;
+    if (!reader.open(resume.planPath)) {
+        QMessageBox::warning(this, "无法续传", "计划文件无法读取：\n" + resume.planPath);
+        return;
+    }
+
+    ExecuteOptions options;
+    options.mode = reader.mode();
+    options.conflictPolicy = reader.conflictPolicy();
+    options.planPath = resume.planPath;
+    options.planCursor = resume.cursor;
+    options.planSkip = resume.handledSources;
+    options.planFailed = failedSources;
+    ExecuteWindow executeWindow(resume.rootPath, QList<QFileInfo>(), QMap<QString, QString>(),
+                                this, options);
+    executeWindow.exec();
+}
+
+void MainWindow::executePlanFile()
+{
+    QString planPath = QFileDialog::getOpenFileName(this, "选择执行计划", QDir::homePath(),
+                                                    "执行计划 (*.ndjson);;所有文件 (*)");
+    if (planPath.isEmpty()) return;
+
+    MovePlanReader reader;
+    if (!reader.open(planPath)) {
+        QMessageBox::warning(this, "无法执行", "不是有效的执行计划文件：\n" + planPath);
+        return;
+    }
+
+    QString summary = QString("目录：%1\n方式：%2\n文件：%3 个")
+                          .arg(reader.rootPath())
+                          .arg(reader.mode() == ExecuteOptions::Copy ? "复制"
+                               : reader.mode() == ExecuteOptions::Link ? "链接" : "移动")
+                          .arg(reader.total() - reader.rejectedLines().size());
+    if (reader.conflicts() > 0) {
+        QString handling;
+        switch (reader.conflictPolicy()) {
+        case ExecuteOptions::RenameWithSuffix: handling = "将自动改名"; break;
+        case ExecuteOptions::SkipExisting:     handling = "将跳过，源文件留在原处"; break;
+        case ExecuteOptions::KeepNewer:        handling = "源文件较新时替换（旧文件移入回收站），否则跳过"; break;
+        case ExecuteOptions::DedupeIdentical:  handling = "内容相同的不再放入，不同的自动改名"; break;
+        }
+        summary += QString("\n其中 %1 个目标已存在，%2").arg(reader.conflicts()).arg(handling);
+    }
+    const QVector<int> &rejected = reader.rejectedLines();
+    if (!rejected.isEmpty()) {
+        // 手工修改过的计划：列出被拒绝的行，避免执行“成功”却少了文件
+        QStringList numbers;
+        for (int i = 0; i < qMin(int(rejected.size()), 20); ++i)
+            numbers << QString::number(rejected.at(i));
+        if (rejected.size() > 20)
+            numbers << "...";
+        summary += QString("\n\n%1 行无效（格式不对，或路径是绝对路径、含 \"..\"），不会执行：\n第 %2 行")
+                       .arg(rejected.size()).arg(numbers.join("、"));
+    }
+    if (QMessageBox::question(this, "按计划执行", summary + "\n\n确定执行吗？") != QMessageBox::Yes)
+        return;
+
+    ExecuteOptions options;
+    options.mode = reader.mode();
+    options.conflictPolicy = reader.conflictPolicy();
+    options.planPath = planPath;
+    ExecuteWindow executeWindow(reader.rootPath(), QList<QFileInfo>(), QMap<QString, QString>(),
+                                this, options);
+    executeWindow.exec();
+}
+
+// 限制扫描、哈希、移动占用的磁盘带宽及优先级，让分类可以在繁忙的机器上后台运行
+void MainWindow::editIoLimits()
+{
+    const IoThrottle::Limits current = IoThrottle::instance().limits();
+
+    QDialog dialog(this);
+    dialog.setWindowTitle("后台 I/O 限制");
+    QFormLayout *form = new QFormLayout(&dialog);
+
+    QSpinBox *opsSpin = new QSpinBox(&dialog);
+    opsSpin->setRange(0, 1000000);
+    opsSpin->setSingleStep(100);
+    opsSpin->setSpecialValueText("不限");
+    opsSpin->setSuffix(" 个/秒");
+    opsSpin->setValue(current.opsPerSec);
+
+    QSpinBox *bytesSpin = new QSpinBox(&dialog);
+    bytesSpin->setRange(0, 100000);
+    bytesSpin->setSingleStep(10);
+    bytesSpin->setSpecialValueText("不限");
+    bytesSpin->setSuffix(" MB/秒");
+    bytesSpin->setValue(int(current.bytesPerSec / (1024 * 1024)));
+
+    QComboBox *classCombo = new QComboBox(&dialog);
+    classCombo->addItem("普通", IoThrottle::BestEffort);
+    classCombo->addItem("仅在磁盘空闲时", IoThrottle::Idle);
+    classCombo->setCurrentIndex(classCombo->findData(current.ioClass));
+
+    QSpinBox *niceSpin = new QSpinBox(&dialog);
+    niceSpin->setRange(0, 19);
+    niceSpin->setValue(current.niceLevel);
+    niceSpin->setToolTip("数值越大，工作线程的 CPU 优先级越低");
+
+    QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dialog);
+    connect(buttons, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+
+    form->addRow("文件操作:", opsSpin);
+    form->addRow("读写速率:", bytesSpin);
+    form->addRow("I/O 优先级:", classCombo);
+    form->addRow("nice 值:", niceSpin);
+    form->addRow(buttons);
+
+    if (dialog.exec() != QDialog::Accepted)
+        return;
+
+    IoThrottle::Limits limits;
+    limits.opsPerSec = opsSpin->value();
+    limits.bytesPerSec = qint64(bytesSpin->value()) * 1024 * 1024;
+    limits.ioClass = static_cast<IoThrottle::IoClass>(classCombo->currentData().toInt());
+    limits.niceLevel = niceSpin->value();
+    IoThrottle::instance().setLimits(limits);
+    IoThrottle::instance().save();
+}
 
 //选择需要分类的文件路径
 void MainWindow::on_choseFileButton_clicked()
@@ -3,6 +3,7 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
+#include "executejournal.h"
 
 
 QT_BEGIN_NAMESPACE
@@ -21,8 +22,14 @@ public:
 
 private slots:
     void on_choseFileButton_clicked(); //选择路径 按钮
+    void executePlanFile();            //按计划文件执行 菜单
+    void editIoLimits();               //后台 I/O 限制 菜单
 
 private:
+    void recoverPendingJournals();     // 处理上次异常退出时遗留的执行日志
+    void resumeInterruptedRun(const QString &journalPath,
+                              const ExecuteJournal::ResumePoint &resume);   // 从断点续传
+
     QString selectedPath = "";
     Ui::MainWindow *ui;
 
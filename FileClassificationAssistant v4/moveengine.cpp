@@ -0,0 +1,523 @@
+// 文件移动引擎：缓存目录句柄，按目录句柄相对路径重命名（或建链接），跨文件系统时退化为复制
+#include "moveengine.h"
+#include "hashcache.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include <filesystem>
+#include <system_error>
+
+#ifdef Q_OS_LINUX
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <linux/fs.h>
+
+// 把 in 的剩余内容写入 out：优先内核内复制，不支持时逐级退化。
+// 退化到分块读写时，经过用户态的数据从 *userSpaceFrom 处起计入 digest，供落盘后回读核对
+static bool copyData(int in, int out, qint64 size, QCryptographicHash *digest, qint64 *userSpaceFrom)
+{
+    qint64 remaining = size;
+
+    // 1. copy_file_range：数据不经过用户态缓冲
+    while (remaining > 0) {
+        ssize_t n = ::copy_file_range(in, nullptr, out, nullptr, size_t(remaining), 0);
+        if (n > 0) { remaining -= n; continue; }
+        if (n < 0 && errno == EINTR) continue;
+        if (n == 0) return false;               // 源文件在复制过程中变短
+        break;                                  // EXDEV/EINVAL/ENOSYS 等：换下一种方式
+    }
+
+    // 2. sendfile：同样在内核中完成
+    while (remaining > 0) {
+        ssize_t n = ::sendfile(out, in, nullptr, size_t(qMin<qint64>(remaining, 1 << 30)));
+        if (n > 0) { remaining -= n; continue; }
+        if (n < 0 && errno == EINTR) continue;
+        if (n == 0) return false;
+        break;
+    }
+
+    // 3. 分块读写，逐块确认写入长度
+    if (remaining > 0) {
+        *userSpaceFrom = size - remaining;
+        QByteArray buffer(1 << 20, Qt::Uninitialized);
+        while (remaining > 0) {
+            ssize_t n = ::read(in, buffer.data(), size_t(qMin<qint64>(remaining, buffer.size())));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            digest->addData(QByteArrayView(buffer.constData(), n));
+            for (ssize_t written = 0; written < n; ) {
+                ssize_t w = ::write(out, buffer.constData() + written, size_t(n - written));
+                if (w < 0 && errno == EINTR) continue;
+                if (w <= 0) return false;
+                written += w;
+            }
+            remaining -= n;
+        }
+    }
+    return true;
+}
+
+// 丢弃 fd 的页缓存后读回 [offset, 文件末尾) 并与写入时的摘要比较，确认落盘的正是读到的数据
+static bool verifyData(int fd, qint64 offset, qint64 size, const QByteArray &expected)
+{
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    QCryptographicHash digest(QCryptographicHash::Sha256);
+    QByteArray buffer(1 << 20, Qt::Uninitialized);
+    while (offset < size) {
+        ssize_t n = ::pread(fd, buffer.data(), size_t(qMin<qint64>(size - offset, buffer.size())), offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        digest.addData(QByteArrayView(buffer.constData(), n));
+        offset += n;
+    }
+    return digest.result() == expected;
+}
+
+// 不覆盖目标的改名。NFS、CIFS、部分 FUSE 及较老的内核不支持 RENAME_NOREPLACE（返回 EINVAL），
+// 此时先建硬链接再删旧名，目标已存在时 linkat 同样以 EEXIST 失败；连硬链接也不支持时，
+// 确认目标不存在后再普通改名。失败时 errno 保持为最后一步的错误，调用方据 EXDEV 判断是否改为复制
+static int renameNoReplace(int fromFd, const char *from, int toFd, const char *to)
+{
+    if (::renameat2(fromFd, from, toFd, to, RENAME_NOREPLACE) == 0)
+        return 0;
+    if (errno != EINVAL && errno != ENOSYS)
+        return -1;
+
+    if (::linkat(fromFd, from, toFd, to, 0) == 0) {
+        if (::unlinkat(fromFd, from, 0) == 0)
+            return 0;
+        const int saved = errno;
+        ::unlinkat(toFd, to, 0);                // 旧名删不掉：撤回新名，保持原状
+        errno = saved;
+        return -1;
+    }
+    if (errno == EEXIST || errno == EXDEV)
+        return -1;
+
+    struct stat st;
+    if (::fstatat(toFd, to, &st, AT_SYMLINK_NOFOLLOW) == 0) {
+        errno = EEXIST;
+        return -1;
+    }
+    return ::renameat(fromFd, from, toFd, to);
+}
+#endif
+
+MoveEngine::MoveEngine(const QString &rootPath, bool queryOnly)
+    : m_rootPath(rootPath),
+    m_queryOnly(queryOnly)
+{
+#ifdef Q_OS_LINUX
+    m_rootFd = ::open(QFile::encodeName(rootPath).constData(),
+                      O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+#endif
+}
+
+MoveEngine::~MoveEngine()
+{
+#ifdef Q_OS_LINUX
+    if (m_rootFd >= 0) ::close(m_rootFd);
+#endif
+}
+
+MoveEngine::Placement MoveEngine::place(const QString &srcPath, const QString &subDir, const QString &name,
+                                        ExecuteOptions::ConflictPolicy policy)
+{
+    Placement placement;
+    QSet<QString> &claimed = m_claimedNames[subDir];
+
+    qint64 dstMTime = 0;
+    if (claimed.contains(name)) {
+        // 本次执行中已有同名文件放到这里（如计划里重复的源），只能改名
+        placement.dstName = uniqueName(subDir, name);
+    } else if (!targetExists(subDir, name, &dstMTime)) {
+        placement.dstName = name;
+    } else {
+        placement.dstName = name;
+        switch (policy) {
+        case ExecuteOptions::SkipExisting:
+            placement.action = Placement::Skip;
+            return placement;
+        case ExecuteOptions::KeepNewer:
+            placement.action = QFileInfo(srcPath).lastModified().toMSecsSinceEpoch() > dstMTime
+                                   ? Placement::Replace : Placement::Skip;
+            break;
+        case ExecuteOptions::DedupeIdentical:
+            if (HashCache::instance().identical(srcPath, targetPath(subDir, name))) {
+                placement.action = Placement::Dedupe;
+                return placement;
+            }
+            placement.dstName = uniqueName(subDir, name);    // 内容不同：保留两份
+            break;
+        case ExecuteOptions::RenameWithSuffix:
+            placement.dstName = uniqueName(subDir, name);
+            break;
+        }
+        if (placement.action == Placement::Skip)
+            return placement;
+    }
+    claimed.insert(placement.dstName);
+    return placement;
+}
+
+QString MoveEngine::moveInto(const QString &srcPath, const QString &subDir, const QString &dstName)
+{
+#ifdef Q_OS_LINUX
+    // 源、目标目录句柄各只打开一次，之后每个文件只需一次 renameat2
+    int srcFd, dstFd;
+    QByteArray srcLocal, dstLocal;
+    if (resolve(srcPath, subDir, dstName, &srcFd, &dstFd, &srcLocal, &dstLocal)) {
+        bool ok = renameNoReplace(srcFd, srcLocal.constData(), dstFd, dstLocal.constData()) == 0;
+        if (!ok && errno == EXDEV) {
+            // 目标在另一个文件系统：复制并确认落盘后再删除源文件
+            qint64 copied = copyFileAt(srcFd, srcLocal, dstFd, dstLocal);
+            if (copied >= 0) {
+                ok = ::unlinkat(srcFd, srcLocal.constData(), 0) == 0;
+                if (ok)
+                    m_copiedBytes += copied;
+                else
+                    ::unlinkat(dstFd, dstLocal.constData(), 0);   // 源文件删不掉则撤回副本
+            }
+        }
+        return ok ? targetPath(subDir, dstName) : QString();
+    }
+#endif
+    // 句柄不可用（非 Linux、子目录名含多级路径等）时走通用路径；QFile::rename 不会覆盖已有文件
+    QString dstPath = preparePortable(subDir, dstName);
+    if (QFile::rename(srcPath, dstPath))
+        return dstPath;
+    return QString();
+}
+
+QString MoveEngine::copyInto(const QString &srcPath, const QString &subDir, const QString &dstName)
+{
+#ifdef Q_OS_LINUX
+    int srcFd, dstFd;
+    QByteArray srcLocal, dstLocal;
+    if (resolve(srcPath, subDir, dstName, &srcFd, &dstFd, &srcLocal, &dstLocal)) {
+        qint64 copied = copyFileAt(srcFd, srcLocal, dstFd, dstLocal);
+        if (copied < 0)
+            return QString();
+        m_copiedBytes += copied;
+        return targetPath(subDir, dstName);
+    }
+#endif
+    QString dstPath = preparePortable(subDir, dstName);
+    if (!QFile::copy(srcPath, dstPath))
+        return QString();
+
+    // 副本沿用源文件的修改时间
+    QFileInfo srcInfo(srcPath);
+    QFile copied(dstPath);
+    if (copied.open(QIODevice::ReadWrite))
+        copied.setFileTime(srcInfo.lastModified(), QFileDevice::FileModificationTime);
+    m_copiedBytes += srcInfo.size();
+    return dstPath;
+}
+
+QString MoveEngine::linkInto(const QString &srcPath, const QString &subDir, const QString &dstName)
+{
+    const QString absoluteSrc = QFileInfo(srcPath).absoluteFilePath();
+#ifdef Q_OS_LINUX
+    int srcFd, dstFd;
+    QByteArray srcLocal, dstLocal;
+    if (resolve(srcPath, subDir, dstName, &srcFd, &dstFd, &srcLocal, &dstLocal)) {
+        bool ok = ::linkat(srcFd, srcLocal.constData(), dstFd, dstLocal.constData(), 0) == 0;
+        // 跨文件系统、文件系统不支持硬链接或链接数已满时退化为符号链接
+        if (!ok && (errno == EXDEV || errno == EPERM || errno == EMLINK))
+            ok = ::symlinkat(QFile::encodeName(absoluteSrc).constData(), dstFd, dstLocal.constData()) == 0;
+        return ok ? targetPath(subDir, dstName) : QString();
+    }
+#endif
+    // 通用路径（Windows 等）同样先建硬链接，跨卷时退化为符号链接（Windows 上需开发者模式或管理员权限）。
+    // 不用 QFile::link：它在 Windows 上建的是 .lnk 快捷方式，以原文件名保存后无法打开
+    QString dstPath = preparePortable(subDir, dstName);
+    const std::filesystem::path from(absoluteSrc.toStdU16String());
+    const std::filesystem::path to(dstPath.toStdU16String());
+    std::error_code error;
+    std::filesystem::create_hard_link(from, to, error);
+    if (error && error != std::errc::file_exists) {
+        error.clear();
+        std::filesystem::create_symlink(from, to, error);
+    }
+    return error ? QString() : dstPath;
+}
+
+bool MoveEngine::restore(const QString &fromPath, const QString &toPath)
+{
+#ifdef Q_OS_LINUX
+    QByteArray fromName, toName;
+    int fromFd = parentDirFd(fromPath, &fromName);
+    int toFd = parentDirFd(toPath, &toName);
+    if (fromFd >= 0 && toFd >= 0) {
+        if (renameNoReplace(fromFd, fromName.constData(), toFd, toName.constData()) == 0)
+            return true;
+        // 跨文件系统时交给 QFile（可复制）
+        if (errno != EXDEV)
+            return false;
+    }
+#endif
+    return QFile::rename(fromPath, toPath);
+}
+
+bool MoveEngine::restoreFromTrash(const QString &trashPath, const QString &toPath)
+{
+    if (!restore(trashPath, toPath))
+        return false;
+    // freedesktop 回收站：files/<名称> 对应 info/<名称>.trashinfo；其他平台没有这个文件，删除自然失败
+    const QFileInfo trashed(trashPath);
+    const QString filesDir = trashed.absolutePath();
+    if (QFileInfo(filesDir).fileName() == "files")
+        QFile::remove(QFileInfo(filesDir).path() + "/info/" + trashed.fileName() + ".trashinfo");
+    return true;
+}
+
+bool MoveEngine::remove(const QString &path)
+{
+#ifdef Q_OS_LINUX
+    QByteArray name;
+    int fd = parentDirFd(path, &name);
+    if (fd >= 0)
+        return ::unlinkat(fd, name.constData(), 0) == 0;
+#endif
+    return QFile::remove(path);
+}
+
+// 名称过长时截短（不拆开代理对），并附上完整名称的短哈希以免不同长名共用一个临时名，
+// 保证整体不超过 NAME_MAX（255 字节）
+QString MoveEngine::partFileName(const QString &name)
+{
+    const QString suffix = ".fca-part";
+    QString base = name;
+    if (QFile::encodeName("." + base + suffix).size() > 255) {
+        const QString tag = "~" + QCryptographicHash::hash(name.toUtf8(), QCryptographicHash::Sha256)
+                                      .toHex().left(8);
+        do {
+            base.chop(base.size() >= 2 && base.at(base.size() - 1).isLowSurrogate() ? 2 : 1);
+        } while (!base.isEmpty() && QFile::encodeName("." + base + tag + suffix).size() > 255);
+        base += tag;
+    }
+    return "." + base + suffix;
+}
+
+QString MoveEngine::targetPath(const QString &subDir, const QString &name) const
+{
+    return QDir(m_rootPath).filePath(subDir + "/" + name);
+}
+
+// 通用路径：确保子目录（可为多级，如计划文件中的 a/b）存在，返回目标路径
+QString MoveEngine::preparePortable(const QString &subDir, const QString &name)
+{
+    QDir dir(m_rootPath);
+    if (!m_createdDirs.contains(subDir)) {
+        if (!dir.exists(subDir))
+            dir.mkpath(subDir);
+        m_createdDirs.insert(subDir);
+    }
+    return targetPath(subDir, name);
+}
+
+// subDir/name 是否已存在（不跟随符号链接），存在时可取回其修改时间
+bool MoveEngine::targetExists(const QString &subDir, const QString &name, qint64 *mtimeMSecs)
+{
+#ifdef Q_OS_LINUX
+    int fd = targetDirFd(subDir);
+    if (fd >= 0) {
+        struct stat st;
+        if (::fstatat(fd, QFile::encodeName(name).constData(), &st, AT_SYMLINK_NOFOLLOW) != 0)
+            return false;
+        if (mtimeMSecs)
+            *mtimeMSecs = qint64(st.st_mtim.tv_sec) * 1000 + st.st_mtim.tv_nsec / 1000000;
+        return true;
+    }
+#endif
+    QFileInfo info(targetPath(subDir, name));
+    if (!info.exists() && !info.isSymLink())
+        return false;
+    if (mtimeMSecs)
+        *mtimeMSecs = info.lastModified().toMSecsSinceEpoch();
+    return true;
+}
+
+// 生成 "名称 (2).扩展名" 形式的未占用文件名
+QString MoveEngine::uniqueName(const QString &subDir, const QString &name)
+{
+    const QSet<QString> &claimed = m_claimedNames[subDir];
+    const int dot = name.lastIndexOf('.');            // dot == 0 为隐藏文件，整名作为基础名
+    const QString base = dot > 0 ? name.left(dot) : name;
+    const QString ext = dot > 0 ? name.mid(dot) : QString();
+    for (int n = 2; ; ++n) {
+        const QString candidate = QString("%1 (%2)%3").arg(base).arg(n).arg(ext);
+        if (!claimed.contains(candidate) && !targetExists(subDir, candidate))
+            return candidate;
+    }
+}
+
+#ifdef Q_OS_LINUX
+// 取得源目录、目标子目录句柄及两边的本地编码文件名；任一句柄不可用时返回 false
+bool MoveEngine::resolve(const QString &srcPath, const QString &subDir, const QString &dstName,
+                         int *srcFd, int *dstFd, QByteArray *srcLocal, QByteArray *dstLocal)
+{
+    *srcFd = parentDirFd(srcPath, srcLocal);
+    *dstFd = targetDirFd(subDir);
+    *dstLocal = QFile::encodeName(dstName);
+    return *srcFd >= 0 && *dstFd >= 0;
+}
+
+// 取得 path 所在目录的句柄（缓存复用）及文件名
+int MoveEngine::parentDirFd(const QString &path, QByteArray *name)
+{
+    const int slash = path.lastIndexOf('/');
+    const QString dir = slash > 0 ? path.left(slash)
+                        : (slash == 0 ? QStringLiteral("/") : QStringLiteral("."));
+    *name = QFile::encodeName(path.mid(slash + 1));
+    return sourceDirFd(dir);
+}
+
+int MoveEngine::sourceDirFd(const QString &dirPath)
+{
+    int fd;
+    if (m_sourceFds.find(dirPath, &fd))
+        return fd;
+
+    fd = ::open(QFile::encodeName(dirPath).constData(),
+                    O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    m_sourceFds.insert(dirPath, fd);
+    return fd;
+}
+
+int MoveEngine::targetDirFd(const QString &subDir)
+{
+    int fd;
+    if (m_targetFds.find(subDir, &fd))
+        return fd;
+
+    fd = -1;
+    if (m_rootFd >= 0 && !subDir.contains('/')) {
+        const QByteArray name = QFile::encodeName(subDir);
+        // 已存在时 mkdirat 返回 EEXIST，直接打开即可；只查询时不创建，目录不存在则走通用路径
+        if (m_queryOnly || ::mkdirat(m_rootFd, name.constData(), 0777) == 0 || errno == EEXIST)
+            fd = ::openat(m_rootFd, name.constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    }
+    m_targetFds.insert(subDir, fd);
+    return fd;
+}
+
+MoveEngine::DirFdCache::~DirFdCache()
+{
+    for (const Entry &entry : std::as_const(m_entries)) {
+        if (entry.fd >= 0) ::close(entry.fd);
+    }
+}
+
+bool MoveEngine::DirFdCache::find(const QString &key, int *fd)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return false;
+    it->lastUse = ++m_clock;
+    *fd = it->fd;
+    return true;
+}
+
+void MoveEngine::DirFdCache::insert(const QString &key, int fd)
+{
+    if (m_entries.size() >= Capacity) {
+        // 容量很小，线性找最久未用的一项即可
+        auto oldest = m_entries.begin();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            if (it->lastUse < oldest->lastUse)
+                oldest = it;
+        }
+        if (oldest->fd >= 0) ::close(oldest->fd);
+        m_entries.erase(oldest);
+    }
+    m_entries.insert(key, Entry{fd, ++m_clock});
+}
+
+// 复制 srcDirFd/srcName 到 dstDirFd/dstName：FICLONE 引用链接 → copy_file_range/sendfile → 分块读写
+// 完成后 fsync 并校验：大小一致、源文件在复制期间未被改动，经用户态复制的部分读回比对哈希。
+// 返回复制的字节数，失败返回 -1 且不留下目标文件（移动时源文件只在校验通过后才删除）
+qint64 MoveEngine::copyFileAt(int srcDirFd, const QByteArray &srcName,
+                              int dstDirFd, const QByteArray &dstName)
+{
+    int in = ::openat(srcDirFd, srcName.constData(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) return -1;
+
+    struct stat st;
+    if (::fstat(in, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(in);
+        return -1;
+    }
+
+    // 先写入临时文件，校验通过后再落名，避免留下不完整的文件。优先用 O_TMPFILE 建匿名文件，
+    // 校验后经 /proc/self/fd 用 linkat 落名（目标已存在时失败，不覆盖），崩溃时不留残留；
+    // 不支持时用带 O_EXCL 的临时文件名，不会截断恰好同名的已有文件
+    QByteArray tmpName;
+    int out = -1;
+#ifdef O_TMPFILE
+    static const bool procFdUsable = ::access("/proc/self/fd", X_OK) == 0;
+    if (procFdUsable)
+        out = ::openat(dstDirFd, ".", O_TMPFILE | O_RDWR | O_CLOEXEC, st.st_mode & 07777);
+#endif
+    if (out < 0) {
+        tmpName = QFile::encodeName(partFileName(QFile::decodeName(dstName)));
+        out = ::openat(dstDirFd, tmpName.constData(),
+                       O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, st.st_mode & 07777);
+    }
+    if (out < 0) {
+        ::close(in);
+        return -1;
+    }
+
+    // 同一文件系统（如 btrfs 子卷之间）可直接共享数据块
+    QCryptographicHash digest(QCryptographicHash::Sha256);
+    qint64 userSpaceFrom = -1;
+    bool ok = ::ioctl(out, FICLONE, in) == 0
+              || copyData(in, out, st.st_size, &digest, &userSpaceFrom);
+    if (ok) {
+        // 保留修改时间（按时间分类依赖它），落盘后核对
+        const struct timespec times[2] = { st.st_atim, st.st_mtim };
+        struct stat srcSt, dstSt;
+        ok = ::futimens(out, times) == 0
+             && ::fsync(out) == 0
+             && ::fstat(out, &dstSt) == 0
+             && dstSt.st_size == st.st_size
+             && ::fstat(in, &srcSt) == 0
+             && srcSt.st_size == st.st_size
+             && srcSt.st_mtim.tv_sec == st.st_mtim.tv_sec
+             && srcSt.st_mtim.tv_nsec == st.st_mtim.tv_nsec;
+        if (ok && userSpaceFrom >= 0)
+            ok = verifyData(out, userSpaceFrom, st.st_size, digest.result());
+    }
+    bool linked = false;
+    if (ok && tmpName.isEmpty()) {
+        char procPath[32];
+        std::snprintf(procPath, sizeof(procPath), "/proc/self/fd/%d", out);
+        ok = linked = ::linkat(AT_FDCWD, procPath, dstDirFd, dstName.constData(), AT_SYMLINK_FOLLOW) == 0;
+    }
+    // 复制完成的数据不再需要留在页缓存里，避免大批量复制挤占缓存
+    ::posix_fadvise(in, 0, 0, POSIX_FADV_DONTNEED);
+    ::posix_fadvise(out, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(in);
+    if (::close(out) != 0) ok = false;
+
+    if (ok && !tmpName.isEmpty())
+        ok = renameNoReplace(dstDirFd, tmpName.constData(), dstDirFd, dstName.constData()) == 0;
+    if (!ok) {
+        if (!tmpName.isEmpty())
+            ::unlinkat(dstDirFd, tmpName.constData(), 0);
+        else if (linked)
+            ::unlinkat(dstDirFd, dstName.constData(), 0);   // 已落名但关闭时报错：撤回
+        return -1;
+    }
+    return st.st_size;
+}
+#endif
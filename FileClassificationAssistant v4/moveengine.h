@@ -0,0 +1,113 @@
+// 文件移动引擎：缓存目录句柄，按目录句柄相对路径重命名（或建链接），跨文件系统时退化为复制
+#ifndef MOVEENGINE_H
+#define MOVEENGINE_H
+
+#include <QString>
+#include <QHash>
+#include <QSet>
+#include "moveexecutor.h"
+
+class MoveEngine
+{
+public:
+    // queryOnly 为 true 时只用于 place() 等查询（如演练），不创建分类目录
+    explicit MoveEngine(const QString &rootPath, bool queryOnly = false);
+    ~MoveEngine();
+
+    MoveEngine(const MoveEngine &) = delete;
+    MoveEngine &operator=(const MoveEngine &) = delete;
+
+    // 一个文件的去向：目标已存在时按冲突策略决定
+    struct Placement {
+        enum Action {
+            Place,                        // 放到 dstName（无冲突或已改名）
+            Skip,                         // 不处理，源文件留在原处
+            Replace,                      // 替换目标（旧目标移入回收站）
+            Dedupe                        // 目标内容与源相同，源文件无需再放入
+        };
+        Action  action = Place;
+        QString dstName;
+    };
+
+    // 为 srcPath 确定以 name 放入 subDir 时的去向；同一引擎内已分配的文件名视为已占用
+    Placement place(const QString &srcPath, const QString &subDir, const QString &name,
+                    ExecuteOptions::ConflictPolicy policy);
+
+    // 将 srcPath 移入根目录下的 subDir/dstName（目标已存在时失败，不覆盖），成功返回目标路径，失败返回空串
+    QString moveInto(const QString &srcPath, const QString &subDir, const QString &dstName);
+
+    // 将 srcPath 复制为根目录下的 subDir/dstName（目标已存在时失败），源文件保持不动
+    QString copyInto(const QString &srcPath, const QString &subDir, const QString &dstName);
+
+    // 在根目录下的 subDir/dstName 建立指向 srcPath 的链接：同一文件系统用硬链接，
+    // 跨文件系统用符号链接；只改元数据，不读写文件内容
+    QString linkInto(const QString &srcPath, const QString &subDir, const QString &dstName);
+
+    QString targetPath(const QString &subDir, const QString &name) const;
+
+    // 复制到 name 时使用的临时文件名（不支持 O_TMPFILE 时）；日志回放据此清理崩溃留下的临时文件
+    static QString partFileName(const QString &name);
+
+    // 撤销用：把 fromPath 改回 toPath（目标已存在时失败，不覆盖）
+    bool restore(const QString &fromPath, const QString &toPath);
+
+    // 撤销用：把移入回收站的 trashPath 放回 toPath，并删除回收站中对应的说明文件（.trashinfo），
+    // 否则回收站里会留下一条指向不存在文件的记录
+    bool restoreFromTrash(const QString &trashPath, const QString &toPath);
+
+    // 撤销用：删除复制出来的副本
+    bool remove(const QString &path);
+
+    // 取出并清零自上次调用以来复制的字节数
+    qint64 takeCopiedBytes() { qint64 n = m_copiedBytes; m_copiedBytes = 0; return n; }
+
+private:
+    QString preparePortable(const QString &subDir, const QString &name);
+    bool targetExists(const QString &subDir, const QString &name, qint64 *mtimeMSecs = nullptr);
+    QString uniqueName(const QString &subDir, const QString &name);
+
+    QString       m_rootPath;
+    QSet<QString> m_createdDirs;          // 已确认存在的分类子目录
+    QHash<QString, QSet<QString>> m_claimedNames;   // 分类子目录 -> 本引擎已分配的文件名
+    bool          m_queryOnly;
+    qint64        m_copiedBytes = 0;
+
+#ifdef Q_OS_LINUX
+    bool resolve(const QString &srcPath, const QString &subDir, const QString &dstName,
+                 int *srcFd, int *dstFd, QByteArray *srcLocal, QByteArray *dstLocal);
+    int parentDirFd(const QString &path, QByteArray *name);
+    int sourceDirFd(const QString &dirPath);
+    int targetDirFd(const QString &subDir);
+    qint64 copyFileAt(int srcDirFd, const QByteArray &srcName,
+                      int dstDirFd, const QByteArray &dstName);
+
+    // 目录句柄缓存：最多 Capacity 个，满时关闭最久未用的一个，长计划涉及再多目录也不会耗尽句柄。
+    // 一次操作至多同时用到同一缓存的两个句柄，刚取用的不会被淘汰
+    class DirFdCache
+    {
+    public:
+        DirFdCache() = default;
+        ~DirFdCache();
+        DirFdCache(const DirFdCache &) = delete;
+        DirFdCache &operator=(const DirFdCache &) = delete;
+
+        bool find(const QString &key, int *fd);   // 命中时更新使用次序
+        void insert(const QString &key, int fd);  // fd 为 -1 时同样缓存（打开失败）
+
+    private:
+        static const int Capacity = 64;
+        struct Entry {
+            int     fd;
+            quint64 lastUse;
+        };
+        QHash<QString, Entry> m_entries;
+        quint64               m_clock = 0;
+    };
+
+    int        m_rootFd;
+    DirFdCache m_sourceFds;               // 源目录路径 -> 目录句柄
+    DirFdCache m_targetFds;               // 分类子目录名 -> 目录句柄
+#endif
+};
+
+#endif // MOVEENGINE_H
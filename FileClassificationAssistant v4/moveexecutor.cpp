@@ -0,0 +1,429 @@
+// 文件移动执行器：在工作线程中成批移动（或复制、链接）文件，进度由界面定时采样
+#include "moveexecutor.h"
+#include "moveengine.h"
+#include "executejournal.h"
+#include "moveplan.h"
+#include "iothrottle.h"
+#include <QDir>
+#include <QFile>
+#include <QThread>
+#include <QThreadPool>
+#include <QMutex>
+#include <QWaitCondition>
+#include <vector>
+
+// 在途字节预算：复制线程开始复制前申请，完成后归还，超出预算时等待
+class ByteBudget
+{
+public:
+    explicit ByteBudget(qint64 limit) : m_limit(qMax<qint64>(limit, 1)) {}
+
+    // 单个文件超过预算时按整个预算计，保证大文件也能独占执行
+    qint64 acquire(qint64 bytes)
+    {
+        bytes = qBound<qint64>(0, bytes, m_limit);
+        QMutexLocker locker(&m_mutex);
+        while (m_inFlight + bytes > m_limit)
+            m_released.wait(&m_mutex);
+        m_inFlight += bytes;
+        return bytes;
+    }
+
+    void release(qint64 bytes)
+    {
+        QMutexLocker locker(&m_mutex);
+        m_inFlight -= bytes;
+        m_released.wakeAll();
+    }
+
+private:
+    const qint64   m_limit;
+    qint64         m_inFlight = 0;
+    QMutex         m_mutex;
+    QWaitCondition m_released;
+};
+
+// 内存中的文件列表作为任务来源（预览窗口直接执行时使用）
+class ListTaskSource : public MoveTaskSource
+{
+public:
+    ListTaskSource(const QList<QFileInfo> &files, const QMap<QString, QString> &folderMap)
+        : m_files(files), m_folderMap(folderMap) {}
+
+    int total() const override { return m_files.size(); }
+    int position() const override { return m_pos; }
+    void rewind() override { m_pos = 0; }
+
+    bool next(QVector<MoveTask> *chunk, int maxCount) override
+    {
+        chunk->clear();
+        const int end = qMin(m_pos + maxCount, int(m_files.size()));
+        for (; m_pos < end; ++m_pos) {
+            const QFileInfo &fi = m_files.at(m_pos);
+            MoveTask task;
+            task.srcPath = fi.filePath();
+            task.subDir = m_folderMap.value(fi.fileName(), "未分类");
+            task.size = fi.size();
+            *chunk << task;
+        }
+        return !chunk->isEmpty();
+    }
+
+private:
+    QList<QFileInfo>      m_files;
+    QMap<QString,QString> m_folderMap;
+    int                   m_pos = 0;
+};
+
+static ExecuteRecord::Kind recordKind(ExecuteOptions::Mode mode)
+{
+    switch (mode) {
+    case ExecuteOptions::Copy: return ExecuteRecord::Copied;
+    case ExecuteOptions::Link: return ExecuteRecord::Linked;
+    case ExecuteOptions::Move: break;
+    }
+    return ExecuteRecord::Moved;
+}
+
+// 按既定去向执行一项任务；跳过或失败时返回的记录 currentPath 为空
+// 移入回收站的文件在日志中记下位置（落盘后才继续），崩溃后回滚也能放回
+static ExecuteRecord carryOut(MoveEngine &engine, const MoveTask &task, const QString &subDir,
+                              const MoveEngine::Placement &placement, ExecuteOptions::Mode mode,
+                              ByteBudget &budget, ExecuteJournal *journal)
+{
+    ExecuteRecord record;
+    record.kind = recordKind(mode);
+    record.originalPath = task.srcPath;
+
+    const QString dstPath = engine.targetPath(subDir, placement.dstName);
+    switch (placement.action) {
+    case MoveEngine::Placement::Skip:
+        return record;
+    case MoveEngine::Placement::Dedupe:
+        // 目标处已有相同内容：复制、链接模式无需再放入；移动模式把多余的源文件移入回收站，可撤销
+        if (mode == ExecuteOptions::Move && QFile::moveToTrash(task.srcPath, &record.currentPath)) {
+            // 回收站中的位置记不进日志就不能保证可恢复：放回原处，本项不处理
+            if (journal && !journal->logTrashed(task.srcPath, record.currentPath)) {
+                engine.restoreFromTrash(record.currentPath, task.srcPath);
+                record.currentPath.clear();
+                return record;
+            }
+            record.kind = ExecuteRecord::Deduped;
+        }
+        return record;
+    case MoveEngine::Placement::Replace:
+        // 旧目标不直接删除，先移入回收站；移不走就放弃替换
+        if (!QFile::moveToTrash(dstPath, &record.displacedPath))
+            return record;
+        // 同上：位置没有落盘就把旧目标放回，放弃替换
+        if (journal && !journal->logTrashed(dstPath, record.displacedPath)) {
+            engine.restoreFromTrash(record.displacedPath, dstPath);
+            record.displacedPath.clear();
+            return record;
+        }
+        break;
+    case MoveEngine::Placement::Place:
+        break;
+    }
+
+    switch (mode) {
+    case ExecuteOptions::Copy: {
+        qint64 reserved = budget.acquire(task.size);
+        record.currentPath = engine.copyInto(task.srcPath, subDir, placement.dstName);
+        budget.release(reserved);
+        break;
+    }
+    case ExecuteOptions::Link:
+        record.currentPath = engine.linkInto(task.srcPath, subDir, placement.dstName);
+        break;
+    case ExecuteOptions::Move:
+        record.currentPath = engine.moveInto(task.srcPath, subDir, placement.dstName);
+        break;
+    }
+
+    // 放入失败时把被替换的旧文件放回
+    if (record.currentPath.isEmpty() && !record.displacedPath.isEmpty()) {
+        engine.restoreFromTrash(record.displacedPath, dstPath);
+        record.displacedPath.clear();
+    }
+    return record;
+}
+
+MoveExecutor::MoveExecutor(const QString &rootPath,
+                           const QList<QFileInfo> &files,
+                           const QMap<QString, QString> &folderMap,
+                           const ExecuteOptions &options,
+                           QObject *parent)
+    : MoveExecutor(new ListTaskSource(files, folderMap), rootPath, options, parent)
+{
+}
+
+MoveExecutor::MoveExecutor(MoveTaskSource *source,
+                           const QString &rootPath,
+                           const ExecuteOptions &options,
+                           QObject *parent)
+    : QObject(parent),
+    m_rootPath(rootPath),
+    m_source(source),
+    m_options(options),
+    m_abort(0),
+    m_paused(0),
+    m_journalFailed(0),
+    m_total(0),
+    m_done(0),
+    m_doneBytes(0),
+    m_copiedBytes(0)
+{
+}
+
+MoveExecutor::~MoveExecutor()
+{
+}
+
+void MoveExecutor::requestAbort()
+{
+    m_abort.storeRelaxed(1);
+    setPaused(false);                 // 暂停中的工作线程需要醒来才能退出
+}
+
+void MoveExecutor::setPaused(bool paused)
+{
+    QMutexLocker locker(&m_pauseMutex);
+    m_paused.storeRelaxed(paused ? 1 : 0);
+    if (!paused)
+        m_resumed.wakeAll();
+}
+
+// 工作线程在批次之间调用：暂停时在此等待，未暂停时只有一次原子读
+void MoveExecutor::waitWhilePaused()
+{
+    if (!m_paused.loadRelaxed())
+        return;
+    QMutexLocker locker(&m_pauseMutex);
+    while (m_paused.loadRelaxed())
+        m_resumed.wait(&m_pauseMutex);
+}
+
+// 把内存中的任务写成计划文件（落盘后）并改为从该文件读取，使中断后可按计划续传；中止时放弃
+bool MoveExecutor::spillToPlan(const QString &planPath)
+{
+    MovePlanWriter writer;
+    if (!writer.open(planPath, m_rootPath, m_options.mode, m_options.conflictPolicy))
+        return false;
+    QVector<MoveTask> tasks;
+    while (!m_abort.loadRelaxed() && m_source->next(&tasks, ChunkSize)) {
+        for (const MoveTask &task : std::as_const(tasks))
+            writer.add(task, false);
+    }
+    MovePlanReader *reader = new MovePlanReader;
+    if (!writer.close() || m_abort.loadRelaxed() || !reader->open(planPath)) {
+        delete reader;
+        QFile::remove(planPath);
+        return false;
+    }
+    m_source.reset(reader);
+    return true;
+}
+
+void MoveExecutor::failJournal()
+{
+    m_journalFailed.storeRelaxed(1);
+    m_abort.storeRelaxed(1);
+}
+
+ExecuteProgress MoveExecutor::progress() const
+{
+    ExecuteProgress progress;
+    progress.done = m_done.loadRelaxed();
+    progress.total = m_total.loadRelaxed();
+    progress.bytes = m_doneBytes.loadRelaxed();
+    progress.copiedBytes = m_copiedBytes.loadRelaxed();
+    QMutexLocker locker(&m_currentMutex);
+    progress.currentFile = m_currentFile;
+    return progress;
+}
+
+void MoveExecutor::setCurrentFile(const QString &path)
+{
+    QMutexLocker locker(&m_currentMutex);
+    m_currentFile = path;
+}
+
+void MoveExecutor::run()
+{
+    // 先公布总数：写出计划可能要一段时间，界面此间也应显示 0/总数
+    m_total.storeRelaxed(m_source->total() - m_source->position());
+    m_done.storeRelaxed(0);
+    m_doneBytes.storeRelaxed(0);
+    m_copiedBytes.storeRelaxed(0);
+
+    // 有日志时执行总是依据计划文件，检查点记录的是计划中的位置
+    if (m_journal && !m_options.dryRun) {
+        if (m_source->planPath().isEmpty() && !spillToPlan(m_journal->companionPlanPath()))
+            m_source->rewind();       // 写不出计划：照常执行，只是不能续传（已中止时下面的循环直接结束）
+        if (!m_source->planPath().isEmpty())
+            m_journal->recordPlan(m_source->planPath(), m_source->position());
+    }
+
+    if (m_options.dryRun) {
+        writePlan();
+        return;
+    }
+
+    const ExecuteOptions::Mode mode = m_options.mode;
+    ByteBudget budget(m_options.inFlightBytes);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(m_options.workerCount > 0 ? m_options.workerCount
+                                                     : QThread::idealThreadCount());
+
+    // 任务按块取出，内存中只保留当前块；块内的处理方式与整批一次完成时相同
+    QVector<MoveTask> tasks;
+    while (!m_abort.loadRelaxed() && m_source->next(&tasks, ChunkSize)) {
+        // 按目标子目录分区：同一目录只由一个工作线程写入，避免目录锁竞争
+        QMap<QString, QVector<int>> partitions;
+        for (int i = 0; i < tasks.size(); ++i)
+            partitions[tasks.at(i).subDir] << i;
+
+        // 1. 确定每个文件的去向（冲突按策略处理）并写入日志。同一目录的文件名由一个引擎分配，
+        //    仍按分区进行；每组意图一次落盘，摊薄 fdatasync 开销
+        std::vector<MoveEngine::Placement> placements(tasks.size());
+        for (auto it = partitions.cbegin(); it != partitions.cend(); ++it) {
+            const QString subDir = it.key();
+            const QVector<int> indices = it.value();
+            pool.start([this, subDir, indices, mode, &tasks, &placements]() {
+                MoveEngine engine(m_rootPath);
+                for (int groupBegin = 0; groupBegin < indices.size() && !m_abort.loadRelaxed();
+                     groupBegin += JournalGroupSize) {
+                    const int groupEnd = qMin(groupBegin + JournalGroupSize, int(indices.size()));
+                    QVector<ExecuteJournal::Entry> intents;
+                    for (int k = groupBegin; k < groupEnd; ++k) {
+                        const int i = indices.at(k);
+                        const MoveTask &task = tasks.at(i);
+                        const MoveEngine::Placement placement =
+                            engine.place(task.srcPath, subDir, task.targetName(), m_options.conflictPolicy);
+                        placements[i] = placement;
+                        if (!m_journal || placement.action == MoveEngine::Placement::Skip
+                            || (mode != ExecuteOptions::Move && placement.action == MoveEngine::Placement::Dedupe))
+                            continue;
+                        ExecuteJournal::Entry entry;
+                        entry.kind = placement.action == MoveEngine::Placement::Dedupe ? ExecuteRecord::Deduped
+                                                                                       : recordKind(mode);
+                        entry.srcPath = task.srcPath;
+                        entry.dstPath = engine.targetPath(subDir, placement.dstName);
+                        entry.replace = placement.action == MoveEngine::Placement::Replace;
+                        intents << entry;
+                    }
+                    if (m_journal && !m_journal->logIntents(intents))
+                        failJournal();
+                }
+            });
+        }
+        pool.waitForDone();
+
+        // 2. 执行。移动、链接只改目录项，按目标目录分区；复制的耗时在数据本身，
+        //    目标常常只有一个分类目录，因此按字节数切成小批分给所有线程，同时在途的字节由 budget 限制
+        QVector<QVector<int>> work;
+        if (mode == ExecuteOptions::Copy) {
+            QVector<int> batch;
+            qint64 batchBytes = 0;
+            for (int i = 0; i < tasks.size(); ++i) {
+                batch << i;
+                batchBytes += tasks.at(i).size;
+                if (batch.size() >= BatchSize || batchBytes >= CopyBatchBytes) {
+                    work << batch;
+                    batch.clear();
+                    batchBytes = 0;
+                }
+            }
+            if (!batch.isEmpty())
+                work << batch;
+        } else {
+            work = partitions.values();
+        }
+
+        // 结果按任务下标存放，各份工作写入的下标互不重叠，无需加锁
+        std::vector<ExecuteRecord> results(tasks.size());
+
+        for (const QVector<int> &indices : std::as_const(work)) {
+            pool.start([this, indices, mode, &tasks, &placements, &results, &budget]() {
+                // 每份工作使用独立的引擎，目录句柄不跨线程共享
+                MoveEngine engine(m_rootPath);
+                IoThrottle &throttle = IoThrottle::instance();
+                throttle.applyToCurrentThread();
+                // 按批执行，批间检查中止、累加进度
+                for (int begin = 0; begin < indices.size() && !m_abort.loadRelaxed(); begin += BatchSize) {
+                    waitWhilePaused();
+                    if (m_abort.loadRelaxed())
+                        break;
+                    const int end = qMin(begin + BatchSize, int(indices.size()));
+                    setCurrentFile(tasks.at(indices.at(begin)).srcPath);
+                    qint64 batchBytes = 0;
+                    for (int k = begin; k < end; ++k) {
+                        const int i = indices.at(k);
+                        // 每个文件记一次操作；复制模式按文件大小预先扣除字节额度
+                        throttle.acquire(1, mode == ExecuteOptions::Copy ? tasks.at(i).size : 0, &m_abort);
+                        results[i] = carryOut(engine, tasks.at(i), tasks.at(i).subDir,
+                                              placements[i], mode, budget, m_journal);
+                        batchBytes += tasks.at(i).size;
+                    }
+                    m_done.fetchAndAddRelaxed(end - begin);
+                    m_doneBytes.fetchAndAddRelaxed(batchBytes);
+                    const qint64 copied = engine.takeCopiedBytes();
+                    m_copiedBytes.fetchAndAddRelaxed(copied);
+                    // 跨文件系统移动时实际复制的字节事后补扣
+                    if (mode == ExecuteOptions::Move)
+                        throttle.acquire(0, copied, &m_abort);
+                }
+            });
+        }
+
+        // 进度由界面定时读取计数，这里只需等待本块完成
+        pool.waitForDone();
+
+        // 整块处理完才记检查点；中途中止的块由日志中的意图补完
+        if (m_journal && !m_abort.loadRelaxed() && !m_source->planPath().isEmpty())
+            m_journal->checkpoint(m_source->position());
+
+        // 按任务顺序合并记录，撤销顺序与线程调度无关
+        for (const ExecuteRecord &record : results) {
+            if (!record.currentPath.isEmpty())
+                m_history << record;
+        }
+    }
+
+    emit finished(m_abort.loadRelaxed() != 0);
+}
+
+void MoveExecutor::writePlan()
+{
+    MovePlanWriter writer;
+    if (!writer.open(m_options.planPath, m_rootPath, m_options.mode, m_options.conflictPolicy)) {
+        emit finished(true);
+        return;
+    }
+
+    // 按冲突策略预先确定文件名（与执行时相同的分配方式），计划中写的就是实际要用的名字
+    MoveEngine engine(m_rootPath, true);
+    QVector<MoveTask> tasks;
+    while (!m_abort.loadRelaxed() && m_source->next(&tasks, ChunkSize)) {
+        for (int begin = 0; begin < tasks.size(); begin += BatchSize) {
+            const int end = qMin(begin + BatchSize, int(tasks.size()));
+            setCurrentFile(tasks.at(begin).srcPath);
+            for (int k = begin; k < end; ++k) {
+                // 目标位置已有同名文件（改名、跳过、替换或去重）时标记为冲突，供审阅
+                MoveTask task = tasks.at(k);
+                const QString name = task.targetName();
+                const MoveEngine::Placement placement =
+                    engine.place(task.srcPath, task.subDir, name, m_options.conflictPolicy);
+                task.dstName = placement.dstName;
+                writer.add(task, placement.action != MoveEngine::Placement::Place
+                                     || placement.dstName != name);
+            }
+            m_done.fetchAndAddRelaxed(end - begin);
+        }
+    }
+
+    const bool ok = writer.close();
+    emit finished(!ok || m_abort.loadRelaxed() != 0);
+}
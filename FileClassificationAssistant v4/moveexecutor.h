@@ -0,0 +1,156 @@
+// 文件移动执行器：在工作线程中成批移动（或复制、链接）文件，进度由界面定时采样
+#ifndef MOVEEXECUTOR_H
+#define MOVEEXECUTOR_H
+
+#include <QObject>
+#include <QList>
+#include <QMap>
+#include <QFileInfo>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QVector>
+#include <QSet>
+#include <QScopedPointer>
+
+class MoveEngine;
+class ExecuteJournal;
+
+// 执行选项
+struct ExecuteOptions {
+    enum Mode { Move, Copy, Link };
+    // 目标位置已有同名文件时的处理方式
+    enum ConflictPolicy {
+        RenameWithSuffix,                      // 改名为 "名称 (2).扩展名"
+        SkipExisting,                          // 跳过，源文件留在原处
+        KeepNewer,                             // 源文件较新时替换（旧文件移入回收站），否则跳过
+        DedupeIdentical                        // 内容相同则不再放入（移动模式下源文件移入回收站），不同则改名
+    };
+    Mode   mode = Move;                        // 移动原文件 / 复制到分类目录 / 在分类目录中建链接（后两者原目录不动）
+    ConflictPolicy conflictPolicy = RenameWithSuffix;
+    int    workerCount = 0;                    // 并发线程数，0 表示按 CPU 核数
+    qint64 inFlightBytes = 256LL * 1024 * 1024; // 复制模式下同时在途的最大字节数
+    bool   dryRun = false;                     // 演练：只把执行计划写入 planPath，不动任何文件
+    QString planPath;                          // 演练时的输出文件；非演练时若设置则按该计划执行
+    int     planCursor = 0;                    // 续传：从计划的第几项开始
+    QSet<QString> planSkip;                    // 续传：已由日志补完、需要跳过的源文件
+    QStringList   planFailed;                  // 续传：日志未能补完、保持原状的源文件，记入新日志
+};
+
+// 一条执行记录，用于撤销
+struct ExecuteRecord {
+    enum Kind {
+        Moved,
+        Copied,
+        Linked,                       // 分类目录中的硬链接或符号链接，撤销时删除链接即可
+        Deduped                       // 与目标重复，源文件已移入回收站（currentPath 为回收站中的位置）
+    };
+    Kind    kind = Moved;
+    QString currentPath;              // 分类后的位置
+    QString originalPath;             // 原位置
+    QString displacedPath;            // 被替换的旧目标文件在回收站中的位置，撤销时放回
+};
+
+// 一项待执行的任务：把 srcPath 放入根目录下的 subDir
+struct MoveTask {
+    QString srcPath;
+    QString subDir;
+    QString dstName;                  // 目标文件名，为空时沿用源文件名（计划文件中可另行指定）
+    qint64  size = 0;
+
+    QString targetName() const { return dstName.isEmpty() ? QFileInfo(srcPath).fileName() : dstName; }
+};
+
+// 任务来源：按块提供任务，执行器不必一次持有全部任务
+class MoveTaskSource
+{
+public:
+    virtual ~MoveTaskSource() {}
+    virtual int total() const = 0;                                  // 任务总数（用于进度）
+    virtual bool next(QVector<MoveTask> *chunk, int maxCount) = 0;  // 取下一块，没有更多任务时返回 false
+    virtual int position() const = 0;                               // 已取出的任务数（断点位置）
+    virtual void rewind() = 0;                                      // 回到第一个任务
+    virtual QString planPath() const { return QString(); }          // 来自计划文件时返回其路径
+};
+
+// 某一时刻的进度快照
+struct ExecuteProgress {
+    int     done = 0;                 // 已处理的文件数
+    int     total = 0;
+    qint64  bytes = 0;                // 已处理文件的总大小
+    qint64  copiedBytes = 0;          // 其中实际复制的字节数（复制模式及跨文件系统移动）
+    QString currentFile;              // 最近开始处理的文件
+};
+
+class MoveExecutor : public QObject
+{
+    Q_OBJECT
+public:
+    MoveExecutor(const QString &rootPath,
+                 const QList<QFileInfo> &files,
+                 const QMap<QString, QString> &folderMap,
+                 const ExecuteOptions &options = ExecuteOptions(),
+                 QObject *parent = nullptr);
+
+    // 从任务来源（如计划文件）执行，接管 source 的所有权
+    MoveExecutor(MoveTaskSource *source,
+                 const QString &rootPath,
+                 const ExecuteOptions &options = ExecuteOptions(),
+                 QObject *parent = nullptr);
+    ~MoveExecutor();
+
+    // 请求中止：可从任意线程调用，各工作线程在当前批次结束后退出
+    void requestAbort();
+
+    // 暂停 / 继续：可从任意线程调用，工作线程在当前批次结束后停下
+    void setPaused(bool paused);
+
+    // 设置执行日志：每组操作开始前先记录意图并落盘；不设置则不记录
+    void setJournal(ExecuteJournal *journal) { m_journal = journal; }
+
+    // 读取当前进度：只读原子计数，可从界面线程随时调用，开销与处理速度无关
+    ExecuteProgress progress() const;
+
+    // 执行日志写入或落盘失败而停止（此时 finished 报告为中止）；仅在 finished 之后读取
+    bool journalFailed() const { return m_journalFailed.loadRelaxed() != 0; }
+
+    // 已完成的执行记录，按原文件列表顺序排列；仅在 finished 之后读取
+    QList<ExecuteRecord> history() const { return m_history; }
+
+public slots:
+    void run();                       // 在工作线程中分派并等待全部移动
+
+signals:
+    void finished(bool aborted);
+
+private:
+    void writePlan();                                           // 演练：把任务连同冲突写成计划文件
+    void waitWhilePaused();                                     // 暂停期间阻塞，继续或中止时返回
+    bool spillToPlan(const QString &planPath);                  // 把内存中的任务写成计划文件，供断点续传
+    void setCurrentFile(const QString &path);
+    void failJournal();                                         // 日志不可用：停止执行，不做无日志的操作
+
+    static const int ChunkSize = 65536;          // 每次从任务来源取出的任务数
+    static const int BatchSize = 256;            // 每批移动的文件数（批间检查中止、累加进度）
+    static const int JournalGroupSize = 2048;    // 每次写入日志并落盘的意图条数（提前于实际操作）
+    static const qint64 CopyBatchBytes = 64LL * 1024 * 1024;   // 复制模式每份工作的大致字节数
+
+    QString                       m_rootPath;
+    QScopedPointer<MoveTaskSource> m_source;
+    ExecuteOptions                m_options;
+    QList<ExecuteRecord>          m_history;
+    ExecuteJournal               *m_journal = nullptr;
+    QAtomicInt                    m_abort;
+    QAtomicInt                    m_paused;
+    QAtomicInt                    m_journalFailed;
+    QMutex                        m_pauseMutex;
+    QWaitCondition                m_resumed;
+    QAtomicInt                    m_total;
+    QAtomicInt                    m_done;        // 所有工作线程累计完成的文件数
+    QAtomicInteger<qint64>        m_doneBytes;   // 已处理文件的累计大小
+    QAtomicInteger<qint64>        m_copiedBytes; // 累计复制的字节数（复制模式及跨文件系统移动）
+    mutable QMutex                m_currentMutex;
+    QString                       m_currentFile; // 每批开始时更新一次，受 m_currentMutex 保护
+};
+
+#endif // MOVEEXECUTOR_H
@@ -0,0 +1,203 @@
+// 执行计划文件：演练时逐条写出 (源, 目标, 冲突)，之后可审阅、比对并按计划执行
+//
+// 格式为 NDJSON（每行一个 JSON 对象），第一行是文件头：
+//   {"conflict":"rename","format":"fca-plan","mode":"move","root":"/home/me/下载","version":1}
+//   {"dst":"图片/a.jpg","size":1024,"src":"a.jpg"}
+//   {"conflict":"exists","dst":"文档/b.pdf","size":2048,"src":"b.pdf"}
+// 路径相对于根目录，键按字母序输出，同一目录两次生成的计划可以直接 diff。
+// 读取时拒绝格式不对或路径越出根目录（绝对路径、含 ".." 段）的行，打开时即按行号报告。
+#include "moveplan.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+
+#if defined(Q_OS_UNIX)
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(Q_OS_WIN)
+#include <io.h>
+#endif
+
+static const char PlanFormat[] = "fca-plan";
+static const int PlanVersion = 1;
+
+// 冲突策略在文件头中的名称，下标与 ExecuteOptions::ConflictPolicy 对应
+static const char *const PolicyNames[] = { "rename", "skip", "keep-newer", "dedupe" };
+
+// 计划中的路径必须在根目录之内：非空、不是绝对路径（含 Windows 盘符）、不含 ".." 段
+static bool isInsideRoot(const QString &path)
+{
+    if (path.isEmpty() || QDir::isAbsolutePath(path)
+        || (path.size() >= 2 && path.at(1) == ':'))    // "C:a.txt" 这类盘符相对路径
+        return false;
+    const QStringList parts = QString(path).replace('\\', '/').split('/');
+    for (const QString &part : parts) {
+        if (part == "..")
+            return false;
+    }
+    return !path.startsWith('/') && !path.startsWith('\\');
+}
+
+// 解析一行任务；JSON 无效、缺少字段、目标没有分类目录或文件名、路径越出根目录时返回 false
+static bool parseTask(const QByteArray &line, const QDir &root, MoveTask *task, bool *conflict)
+{
+    QJsonParseError error;
+    const QJsonObject object = QJsonDocument::fromJson(line, &error).object();
+    if (error.error != QJsonParseError::NoError)
+        return false;
+    const QString src = object.value("src").toString();
+    const QString dst = object.value("dst").toString();
+    const int slash = dst.lastIndexOf('/');
+    if (!isInsideRoot(src) || !isInsideRoot(dst) || slash <= 0 || slash == dst.size() - 1)
+        return false;
+
+    // 目标按原样执行：目录部分为分类子目录，文件名为审阅后的名字
+    task->srcPath = root.filePath(src);
+    task->subDir = dst.left(slash);
+    task->dstName = dst.mid(slash + 1);
+    task->size = object.value("size").toInteger();
+    *conflict = object.contains("conflict");
+    return true;
+}
+
+bool MovePlanWriter::open(const QString &path, const QString &rootPath, ExecuteOptions::Mode mode,
+                          ExecuteOptions::ConflictPolicy policy)
+{
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    m_rootPath = rootPath;
+    m_count = 0;
+    m_conflicts = 0;
+
+    QJsonObject header;
+    header["format"] = PlanFormat;
+    header["version"] = PlanVersion;
+    header["root"] = rootPath;
+    header["mode"] = mode == ExecuteOptions::Copy ? "copy"
+                     : mode == ExecuteOptions::Link ? "link" : "move";
+    header["conflict"] = PolicyNames[policy];
+    m_file.write(QJsonDocument(header).toJson(QJsonDocument::Compact) + "\n");
+    return true;
+}
+
+void MovePlanWriter::add(const MoveTask &task, bool conflict)
+{
+    const QDir root(m_rootPath);
+    QJsonObject line;
+    line["src"] = root.relativeFilePath(task.srcPath);
+    line["dst"] = task.subDir + "/" + task.targetName();
+    line["size"] = task.size;
+    if (conflict) {
+        line["conflict"] = "exists";          // 目标位置已有同名文件，执行时按冲突策略处理
+        ++m_conflicts;
+    }
+    m_file.write(QJsonDocument(line).toJson(QJsonDocument::Compact) + "\n");
+    ++m_count;
+}
+
+bool MovePlanWriter::close()
+{
+    // 执行日志会引用计划文件并落盘，计划本身必须先落盘，否则崩溃后续传读到的是截断的计划
+    bool ok = m_file.error() == QFileDevice::NoError && m_file.flush();
+#if defined(Q_OS_UNIX)
+    ok = ok && ::fsync(m_file.handle()) == 0;
+#elif defined(Q_OS_WIN)
+    ok = ok && ::_commit(m_file.handle()) == 0;
+#endif
+    m_file.close();
+
+#if defined(Q_OS_UNIX)
+    // 新建的目录项也要落盘
+    if (ok) {
+        int dirFd = ::open(QFile::encodeName(QFileInfo(m_file.fileName()).absolutePath()).constData(),
+                           O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirFd >= 0) {
+            ::fsync(dirFd);
+            ::close(dirFd);
+        }
+    }
+#endif
+    return ok;
+}
+
+bool MovePlanReader::open(const QString &path)
+{
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly))
+        return false;
+
+    const QJsonObject header = QJsonDocument::fromJson(m_file.readLine()).object();
+    if (header.value("format").toString() != PlanFormat
+        || header.value("version").toInt() > PlanVersion)
+        return false;
+    m_rootPath = header.value("root").toString();
+    const QString mode = header.value("mode").toString();
+    m_mode = mode == "copy" ? ExecuteOptions::Copy
+             : mode == "link" ? ExecuteOptions::Link : ExecuteOptions::Move;
+    const QString policy = header.value("conflict").toString();
+    m_policy = ExecuteOptions::RenameWithSuffix;
+    for (int i = 0; i < int(sizeof(PolicyNames) / sizeof(PolicyNames[0])); ++i) {
+        if (policy == PolicyNames[i])
+            m_policy = ExecuteOptions::ConflictPolicy(i);
+    }
+
+    // 先顺序扫一遍：统计条数和冲突数，逐行校验并记下无效行的行号（文件头为第 1 行），再回到正文开头
+    m_bodyStart = m_file.pos();
+    m_total = 0;
+    m_conflicts = 0;
+    m_position = 0;
+    m_rejectedLines.clear();
+    const QDir root(m_rootPath);
+    for (int lineNumber = 2; !m_file.atEnd(); ++lineNumber) {
+        const QByteArray line = m_file.readLine();
+        if (line.trimmed().isEmpty()) continue;
+        ++m_total;
+        MoveTask task;
+        bool conflict;
+        if (!parseTask(line, root, &task, &conflict))
+            m_rejectedLines << lineNumber;
+        else if (conflict)
+            ++m_conflicts;
+    }
+    return m_file.seek(m_bodyStart);
+}
+
+void MovePlanReader::rewind()
+{
+    m_file.seek(m_bodyStart);
+    m_position = 0;
+}
+
+void MovePlanReader::resumeFrom(int cursor, const QSet<QString> &skipSources)
+{
+    // 只数行，不解析 JSON
+    while (m_position < cursor && !m_file.atEnd()) {
+        if (!m_file.readLine().trimmed().isEmpty())
+            ++m_position;
+    }
+    m_skipSources = skipSources;
+}
+
+bool MovePlanReader::next(QVector<MoveTask> *chunk, int maxCount)
+{
+    chunk->clear();
+    const QDir root(m_rootPath);
+    while (chunk->size() < maxCount && !m_file.atEnd()) {
+        const QByteArray line = m_file.readLine();
+        if (line.trimmed().isEmpty())
+            continue;
+        ++m_position;
+        MoveTask task;
+        bool conflict;
+        if (!parseTask(line, root, &task, &conflict))
+            continue;                          // 无效行，打开时已报告
+        if (!m_skipSources.isEmpty() && m_skipSources.remove(task.srcPath))
+            continue;                          // 中断前已记录意图，已由日志补完
+        *chunk << task;
+    }
+    return !chunk->isEmpty();
+}
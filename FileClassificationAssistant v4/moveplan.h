@@ -0,0 +1,63 @@
+// 执行计划文件：演练时逐条写出 (源, 目标, 冲突)，之后可审阅、比对并按计划执行
+#ifndef MOVEPLAN_H
+#define MOVEPLAN_H
+
+#include "moveexecutor.h"
+#include <QFile>
+#include <QSet>
+
+// 逐条写出计划，不在内存中累积
+class MovePlanWriter
+{
+public:
+    bool open(const QString &path, const QString &rootPath, ExecuteOptions::Mode mode,
+              ExecuteOptions::ConflictPolicy policy);
+    void add(const MoveTask &task, bool conflict);
+    bool close();                     // 写完、落盘并关闭，返回是否全部写入成功
+
+    int count() const { return m_count; }
+    int conflicts() const { return m_conflicts; }
+
+private:
+    QFile   m_file;
+    QString m_rootPath;
+    int     m_count = 0;
+    int     m_conflicts = 0;
+};
+
+// 按块读取计划，作为执行器的任务来源
+class MovePlanReader : public MoveTaskSource
+{
+public:
+    bool open(const QString &path);   // 读取文件头并统计条数；格式不对时返回 false
+
+    QString rootPath() const { return m_rootPath; }
+    ExecuteOptions::Mode mode() const { return m_mode; }
+    ExecuteOptions::ConflictPolicy conflictPolicy() const { return m_policy; }
+    int conflicts() const { return m_conflicts; }
+    // 被拒绝的行（格式不对或路径越出根目录）的行号，执行时跳过；total() 含这些行
+    const QVector<int> &rejectedLines() const { return m_rejectedLines; }
+
+    // 续传：跳到第 cursor 项，之后遇到 skipSources 中的源文件也跳过
+    void resumeFrom(int cursor, const QSet<QString> &skipSources);
+
+    int total() const override { return m_total; }
+    bool next(QVector<MoveTask> *chunk, int maxCount) override;
+    int position() const override { return m_position; }
+    void rewind() override;
+    QString planPath() const override { return m_file.fileName(); }
+
+private:
+    QFile                m_file;
+    QString              m_rootPath;
+    ExecuteOptions::Mode m_mode = ExecuteOptions::Move;
+    ExecuteOptions::ConflictPolicy m_policy = ExecuteOptions::RenameWithSuffix;
+    int                  m_total = 0;
+    int                  m_conflicts = 0;
+    int                  m_position = 0;           // 已读过的任务行数
+    qint64               m_bodyStart = 0;          // 第一条任务在文件中的偏移
+    QSet<QString>        m_skipSources;
+    QVector<int>         m_rejectedLines;
+};
+
+#endif // MOVEPLAN_H
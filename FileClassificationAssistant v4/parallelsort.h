@@ -0,0 +1,49 @@
+// 并行排序：分块在线程池中各自排序，再逐轮两两归并
+#ifndef PARALLELSORT_H
+#define PARALLELSORT_H
+
+#include <QThread>
+#include <QThreadPool>
+#include <QtGlobal>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+template <typename RandomIt, typename Compare>
+void parallelSort(RandomIt first, RandomIt last, Compare comp)
+{
+    const qint64 count = std::distance(first, last);
+    const qint64 MinChunk = 32768;            // 小于此规模时分块的开销大于收益
+
+    int chunks = 1;
+    while (chunks * 2 <= QThread::idealThreadCount() && count / (chunks * 2) >= MinChunk)
+        chunks *= 2;
+    if (chunks == 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    std::vector<RandomIt> bounds;
+    for (int i = 0; i <= chunks; ++i)
+        bounds.push_back(first + count * i / chunks);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(chunks);
+    for (int i = 0; i < chunks; ++i) {
+        const RandomIt begin = bounds[i], end = bounds[i + 1];
+        pool.start([begin, end, comp]() { std::sort(begin, end, comp); });
+    }
+    pool.waitForDone();
+
+    // 每轮把相邻两块归并为一块，块数减半
+    for (int width = 1; width < chunks; width *= 2) {
+        for (int i = 0; i + width < chunks; i += 2 * width) {
+            const RandomIt begin = bounds[i], middle = bounds[i + width];
+            const RandomIt end = bounds[qMin(i + 2 * width, chunks)];
+            pool.start([begin, middle, end, comp]() { std::inplace_merge(begin, middle, end, comp); });
+        }
+        pool.waitForDone();
+    }
+}
+
+#endif // PARALLELSORT_H
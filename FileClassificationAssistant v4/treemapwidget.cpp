@@ -0,0 +1,400 @@
+// 空间占用矩形树图：按文件类型分组、按字节数划分面积（squarified 布局），布局在后台线程计算
+#include "treemapwidget.h"
+#include "filecatalog.h"
+#include <QPainter>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <QHelpEvent>
+#include <QToolTip>
+#include <QHash>
+#include <QLocale>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static const qreal MaxZoom = 1e6;
+static const int RelayoutDelayMs = 200;
+
+// squarified 布局（Bruls 等）：把降序、均大于 0 的 values 按面积比例铺进 rect。
+// 每次从剩余矩形的短边排一行，行内继续加入文件直到最差长宽比变坏；
+// 各文件的矩形写入 out，每排完一行调用 onStrip(first, last, stripRect, vertical)
+template <typename OnStrip>
+static void squarify(const qint64 *values, int count, QRectF rect, QRectF *out, OnStrip onStrip)
+{
+    double total = 0;
+    for (int i = 0; i < count; ++i)
+        total += values[i];
+
+    int begin = 0;
+    while (begin < count && total > 0 && rect.width() > 0 && rect.height() > 0) {
+        const double scale = rect.width() * rect.height() / total;   // 每字节的面积
+        const bool vertical = rect.width() >= rect.height();          // 宽的矩形在左侧竖排一列
+        const double side = vertical ? rect.height() : rect.width();
+
+        double rowSum = 0;
+        double worst = std::numeric_limits<double>::max();
+        int end = begin;
+        while (end < count) {
+            const double area = (rowSum + values[end]) * scale;
+            const double maxArea = values[begin] * scale;
+            const double minArea = values[end] * scale;
+            const double ratio = qMax(side * side * maxArea / (area * area),
+                                      area * area / (side * side * minArea));
+            if (end > begin && ratio > worst)
+                break;
+            worst = ratio;
+            rowSum += values[end];
+            ++end;
+        }
+
+        const double thickness = rowSum * scale / side;
+        const QRectF strip = vertical ? QRectF(rect.left(), rect.top(), thickness, rect.height())
+                                      : QRectF(rect.left(), rect.top(), rect.width(), thickness);
+        double pos = vertical ? strip.top() : strip.left();
+        for (int i = begin; i < end; ++i) {
+            const double length = values[i] * scale / thickness;
+            out[i] = vertical ? QRectF(strip.left(), pos, thickness, length)
+                              : QRectF(pos, strip.top(), length, thickness);
+            pos += length;
+        }
+        onStrip(begin, end, strip, vertical);
+
+        total -= rowSum;
+        rect = vertical ? rect.adjusted(thickness, 0, 0, 0) : rect.adjusted(0, thickness, 0, 0);
+        begin = end;
+    }
+}
+
+// 在工作线程中计算整张图；generation 变化说明结果已不需要，提前返回空
+static QSharedPointer<TreemapWidget::Layout> buildLayout(const FileCatalog &catalog, const QSizeF &size,
+                                                         const QAtomicInt &generation, int expected)
+{
+    typedef TreemapWidget::Group Group;
+    QSharedPointer<TreemapWidget::Layout> layout = QSharedPointer<TreemapWidget::Layout>::create();
+    layout->size = size;
+
+    // 按类型分组，口径与按类型分类一致；0 字节的文件不占面积，不参与
+    QHash<QString, int> groupIndex;
+    QVector<Group> groups;
+    QVector<QVector<int>> groupFiles;
+    for (int id = 0; id < catalog.size(); ++id) {
+        if (catalog.fileSize(id) <= 0)
+            continue;
+        QString key = catalog.suffix(id).toLower();
+        if (key.isEmpty()) key = "无后缀";
+        auto it = groupIndex.constFind(key);
+        int index;
+        if (it == groupIndex.constEnd()) {
+            index = groups.size();
+            groupIndex.insert(key, index);
+            Group group;
+            group.key = key;
+            group.color = QColor::fromHsv(int(qHash(key) % 360), 110, 215);
+            groups << group;
+            groupFiles << QVector<int>();
+        } else {
+            index = it.value();
+        }
+        groups[index].bytes += catalog.fileSize(id);
+        groups[index].fileCount++;
+        groupFiles[index] << id;
+    }
+
+    QVector<int> order(groups.size());
+    for (int i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&groups](int a, int b) {
+        return groups.at(a).bytes > groups.at(b).bytes;
+    });
+
+    // 第一层：类型
+    QVector<qint64> groupBytes;
+    for (int g : std::as_const(order))
+        groupBytes << groups.at(g).bytes;
+    QVector<QRectF> groupRects(order.size());
+    squarify(groupBytes.constData(), groupBytes.size(), QRectF(QPointF(0, 0), size), groupRects.data(),
+             [](int, int, const QRectF &, bool) {});
+
+    // 第二层：各类型内的文件，按大小降序
+    layout->items.reserve(catalog.size());
+    for (int k = 0; k < order.size(); ++k) {
+        if (generation.loadRelaxed() != expected)
+            return QSharedPointer<TreemapWidget::Layout>();
+
+        Group group = groups.at(order.at(k));
+        group.rect = groupRects.at(k);
+        QVector<int> ids = groupFiles.at(order.at(k));
+        std::sort(ids.begin(), ids.end(), [&catalog](int a, int b) {
+            const qint64 sa = catalog.fileSize(a), sb = catalog.fileSize(b);
+            return sa != sb ? sa > sb : a < b;
+        });
+
+        QVector<qint64> values(ids.size());
+        for (int i = 0; i < ids.size(); ++i)
+            values[i] = catalog.fileSize(ids.at(i));
+        QVector<QRectF> rects(ids.size());
+
+        const int itemBase = layout->items.size();
+        group.firstStrip = layout->strips.size();
+        squarify(values.constData(), values.size(), group.rect, rects.data(),
+                 [&layout, itemBase](int first, int last, const QRectF &rect, bool vertical) {
+                     layout->strips.append({rect, itemBase + first, itemBase + last, vertical});
+                 });
+        group.lastStrip = layout->strips.size();
+        for (int i = 0; i < ids.size(); ++i)
+            layout->items.append({rects.at(i), ids.at(i)});
+
+        layout->groups << group;
+    }
+    return layout;
+}
+
+TreemapWidget::TreemapWidget(QWidget *parent)
+    : QWidget(parent),
+    m_generation(0)
+{
+    m_layoutPool.setMaxThreadCount(1);
+    m_relayoutTimer.setSingleShot(true);
+    m_relayoutTimer.setInterval(RelayoutDelayMs);
+    connect(&m_relayoutTimer, &QTimer::timeout, this, &TreemapWidget::requestLayout);
+
+    setMinimumSize(200, 150);
+}
+
+TreemapWidget::~TreemapWidget()
+{
+    m_generation.fetchAndAddRelaxed(1);   // 让进行中的布局尽快返回
+    m_layoutPool.waitForDone();
+}
+
+void TreemapWidget::setCatalog(const QSharedPointer<const FileCatalog> &catalog)
+{
+    m_catalog = catalog;
+    m_layout.reset();
+    m_zoom = 1.0;
+    m_origin = QPointF();
+    requestLayout();
+    update();
+}
+
+void TreemapWidget::requestLayout()
+{
+    if (!m_catalog || width() <= 0 || height() <= 0)
+        return;
+
+    const int generation = m_generation.fetchAndAddRelaxed(1) + 1;
+    const QSharedPointer<const FileCatalog> catalog = m_catalog;
+    const QSizeF size = this->size();
+    m_layoutPool.start([this, catalog, size, generation]() {
+        QSharedPointer<const Layout> layout = buildLayout(*catalog, size, m_generation, generation);
+        if (!layout)
+            return;
+        // 析构函数会等本任务结束，this 在此仍有效；对象随后销毁时未处理的排队调用一并丢弃
+        QMetaObject::invokeMethod(this, [this, layout, generation]() {
+            applyLayout(layout, generation);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void TreemapWidget::applyLayout(const QSharedPointer<const Layout> &layout, int generation)
+{
+    if (generation != m_generation.loadRelaxed())
+        return;                           // 之后又请求过布局，这份已过时
+
+    // 视口按比例换算到新布局，缩放位置保持不变
+    if (m_layout && !m_layout->size.isEmpty()) {
+        m_origin.rx() *= layout->size.width() / m_layout->size.width();
+        m_origin.ry() *= layout->size.height() / m_layout->size.height();
+    }
+    m_layout = layout;
+    update();
+}
+
+QRectF TreemapWidget::toScreen(const QRectF &rect) const
+{
+    const qreal sx = width() / m_layout->size.width() * m_zoom;
+    const qreal sy = height() / m_layout->size.height() * m_zoom;
+    return QRectF((rect.left() - m_origin.x()) * sx, (rect.top() - m_origin.y()) * sy,
+                  rect.width() * sx, rect.height() * sy);
+}
+
+QPointF TreemapWidget::toLayout(const QPointF &point) const
+{
+    const qreal sx = width() / m_layout->size.width() * m_zoom;
+    const qreal sy = height() / m_layout->size.height() * m_zoom;
+    return QPointF(m_origin.x() + point.x() / sx, m_origin.y() + point.y() / sy);
+}
+
+void TreemapWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor("#ffffff"));
+
+    if (!m_layout) {
+        painter.setPen(QColor("#7f8c8d"));
+        painter.drawText(rect(), Qt::AlignCenter, m_catalog ? "正在计算布局..." : "没有数据");
+        return;
+    }
+
+    // 细节层次：类型整块先按颜色填满，不足一个像素的条带、文件不再单独绘制，由这块底色代表；
+    // 条带内文件按大小降序，遇到第一个不足一像素的即可结束该条带
+    const QRectF view = rect();
+    const QFontMetrics metrics(font());
+    for (const Group &group : m_layout->groups) {
+        const QRectF groupRect = toScreen(group.rect);
+        if (!groupRect.intersects(view))
+            continue;
+        painter.fillRect(groupRect, group.color);
+        if (groupRect.width() < 3 || groupRect.height() < 3)
+            continue;
+
+        painter.setPen(group.color.darker(125));
+        for (int s = group.firstStrip; s < group.lastStrip; ++s) {
+            const Strip &strip = m_layout->strips.at(s);
+            const QRectF stripRect = toScreen(strip.rect);
+            if (stripRect.width() < 1 || stripRect.height() < 1 || !stripRect.intersects(view))
+                continue;
+
+            for (int i = strip.firstItem; i < strip.lastItem; ++i) {
+                const QRectF itemRect = toScreen(m_layout->items.at(i).rect);
+                const qreal length = strip.vertical ? itemRect.height() : itemRect.width();
+                if (length < 1)
+                    break;
+                // 条带内文件沿一个方向排开：视口之前的跳过，越过视口即结束
+                const qreal start = strip.vertical ? itemRect.top() : itemRect.left();
+                const qreal stop = strip.vertical ? itemRect.bottom() : itemRect.right();
+                if (stop < (strip.vertical ? view.top() : view.left()))
+                    continue;
+                if (start > (strip.vertical ? view.bottom() : view.right()))
+                    break;
+
+                painter.drawRect(itemRect);
+                if (itemRect.width() > 60 && itemRect.height() > metrics.height() + 2) {
+                    painter.setPen(QColor("#2c3e50"));
+                    const int fileId = m_layout->items.at(i).fileId;
+                    painter.drawText(itemRect.adjusted(3, 1, -3, -1), Qt::AlignLeft | Qt::AlignTop,
+                                     metrics.elidedText(m_catalog->fileName(fileId), Qt::ElideMiddle,
+                                                        int(itemRect.width()) - 6));
+                    painter.setPen(group.color.darker(125));
+                }
+            }
+        }
+
+        // 类型边框及名称
+        painter.setPen(QPen(QColor("#34495e"), 1.5));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawRect(groupRect);
+        if (groupRect.width() > 50 && groupRect.height() > metrics.height() * 2) {
+            const QString label = QString("%1 (%2)").arg(group.key, QLocale().formattedDataSize(group.bytes));
+            const QRectF labelRect(groupRect.left() + 2, groupRect.bottom() - metrics.height() - 2,
+                                   groupRect.width() - 4, metrics.height());
+            painter.fillRect(labelRect, QColor(255, 255, 255, 200));
+            painter.setPen(QColor("#2c3e50"));
+            painter.drawText(labelRect, Qt::AlignCenter,
+                             metrics.elidedText(label, Qt::ElideRight, int(labelRect.width())));
+        }
+    }
+}
+
+void TreemapWidget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    // 先按比例拉伸旧布局，停止调整后再重新计算
+    m_relayoutTimer.start();
+}
+
+void TreemapWidget::wheelEvent(QWheelEvent *event)
+{
+    if (!m_layout)
+        return;
+
+    // 以光标为中心缩放
+    const QPointF pos = event->position();
+    const QPointF anchor = toLayout(pos);
+    const qreal factor = std::pow(1.25, event->angleDelta().y() / 120.0);
+    m_zoom = qBound<qreal>(1.0, m_zoom * factor, MaxZoom);
+
+    const qreal sx = width() / m_layout->size.width() * m_zoom;
+    const qreal sy = height() / m_layout->size.height() * m_zoom;
+    const QSizeF visible(m_layout->size.width() / m_zoom, m_layout->size.height() / m_zoom);
+    m_origin = QPointF(qBound<qreal>(0, anchor.x() - pos.x() / sx, m_layout->size.width() - visible.width()),
+                       qBound<qreal>(0, anchor.y() - pos.y() / sy, m_layout->size.height() - visible.height()));
+    update();
+    event->accept();
+}
+
+void TreemapWidget::mousePressEvent(QMouseEvent *event)
+{
+    m_lastMousePos = event->pos();
+}
+
+void TreemapWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    if (!m_layout || !(event->buttons() & Qt::LeftButton))
+        return;
+
+    // 拖动平移
+    const QPoint delta = event->pos() - m_lastMousePos;
+    m_lastMousePos = event->pos();
+    const qreal sx = width() / m_layout->size.width() * m_zoom;
+    const qreal sy = height() / m_layout->size.height() * m_zoom;
+    const QSizeF visible(m_layout->size.width() / m_zoom, m_layout->size.height() / m_zoom);
+    m_origin = QPointF(qBound<qreal>(0, m_origin.x() - delta.x() / sx, m_layout->size.width() - visible.width()),
+                       qBound<qreal>(0, m_origin.y() - delta.y() / sy, m_layout->size.height() - visible.height()));
+    update();
+}
+
+void TreemapWidget::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    Q_UNUSED(event);
+    // 恢复全图
+    m_zoom = 1.0;
+    m_origin = QPointF();
+    update();
+}
+
+bool TreemapWidget::event(QEvent *event)
+{
+    if (event->type() == QEvent::ToolTip) {
+        const QHelpEvent *helpEvent = static_cast<QHelpEvent *>(event);
+        const QString text = toolTipAt(helpEvent->pos());
+        if (text.isEmpty())
+            QToolTip::hideText();
+        else
+            QToolTip::showText(helpEvent->globalPos(), text, this);
+        return true;
+    }
+    return QWidget::event(event);
+}
+
+QString TreemapWidget::toolTipAt(const QPointF &pos) const
+{
+    if (!m_layout)
+        return QString();
+
+    const QPointF point = toLayout(pos);
+    const QLocale locale;
+    for (const Group &group : m_layout->groups) {
+        if (!group.rect.contains(point))
+            continue;
+        const QString groupText = QString("%1：%2 个文件，%3")
+                                      .arg(group.key).arg(group.fileCount)
+                                      .arg(locale.formattedDataSize(group.bytes));
+        for (int s = group.firstStrip; s < group.lastStrip; ++s) {
+            const Strip &strip = m_layout->strips.at(s);
+            if (!strip.rect.contains(point))
+                continue;
+            for (int i = strip.firstItem; i < strip.lastItem; ++i) {
+                const Item &item = m_layout->items.at(i);
+                if (item.rect.contains(point)) {
+                    return QString("%1\n%2\n%3").arg(m_catalog->fileName(item.fileId),
+                                                     locale.formattedDataSize(m_catalog->fileSize(item.fileId)),
+                                                     groupText);
+                }
+            }
+        }
+        return groupText;
+    }
+    return QString();
+}
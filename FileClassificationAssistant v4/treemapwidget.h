@@ -0,0 +1,81 @@
+// 空间占用矩形树图：按文件类型分组、按字节数划分面积（squarified 布局），布局在后台线程计算
+#ifndef TREEMAPWIDGET_H
+#define TREEMAPWIDGET_H
+
+#include <QWidget>
+#include <QSharedPointer>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QVector>
+#include <QColor>
+#include <QRectF>
+#include <QTimer>
+
+class FileCatalog;
+
+class TreemapWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit TreemapWidget(QWidget *parent = nullptr);
+    ~TreemapWidget() override;
+
+    // 设置数据并在后台计算布局；catalog 由本控件共同持有
+    void setCatalog(const QSharedPointer<const FileCatalog> &catalog);
+
+    // 布局结果：矩形均在布局坐标（计算时的控件尺寸）中，绘制时再按缩放、平移变换
+    struct Item {
+        QRectF rect;
+        int    fileId;
+    };
+    struct Strip {                        // squarified 的一行：一组沿同一方向排开的文件，按大小降序
+        QRectF rect;
+        int    firstItem;
+        int    lastItem;                  // 不含
+        bool   vertical;                  // 文件在条带内自上而下排列
+    };
+    struct Group {                        // 一种文件类型
+        QString key;
+        qint64  bytes = 0;
+        int     fileCount = 0;
+        QRectF  rect;
+        QColor  color;
+        int     firstStrip = 0;
+        int     lastStrip = 0;            // 不含
+    };
+    struct Layout {
+        QSizeF          size;
+        QVector<Group>  groups;
+        QVector<Strip>  strips;
+        QVector<Item>   items;
+    };
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+    bool event(QEvent *event) override;
+
+private:
+    void requestLayout();                 // 按当前尺寸在后台重新布局
+    void applyLayout(const QSharedPointer<const Layout> &layout, int generation);
+    QRectF toScreen(const QRectF &rect) const;
+    QPointF toLayout(const QPointF &point) const;
+    QString toolTipAt(const QPointF &pos) const;
+
+    QSharedPointer<const FileCatalog> m_catalog;
+    QSharedPointer<const Layout>      m_layout;
+
+    QThreadPool m_layoutPool;             // 单线程，析构时等待进行中的布局结束
+    QAtomicInt  m_generation;             // 每次请求布局加一，旧结果到达时丢弃、进行中的计算提前结束
+    QTimer      m_relayoutTimer;          // 调整大小时合并多次请求
+
+    qreal   m_zoom = 1.0;                 // 1 为整图恰好铺满
+    QPointF m_origin;                     // 视口左上角对应的布局坐标
+    QPoint  m_lastMousePos;               // 拖动平移
+};
+
+#endif // TREEMAPWIDGET_H